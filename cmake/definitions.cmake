@@ -153,6 +153,14 @@ if( GT_ENABLE_BACKEND_MC )
   add_library(GridToolsTestMC INTERFACE)
   target_compile_definitions(GridToolsTestMC INTERFACE GT_BACKEND_MC)
   target_link_libraries(GridToolsTestMC INTERFACE GridToolsTest)
+  if( GT_ENABLE_LIBNUMA )
+    find_library( NUMA_LIBRARY numa )
+    if( NOT NUMA_LIBRARY )
+      message( FATAL_ERROR "GT_ENABLE_LIBNUMA is set, but libnuma was not found" )
+    endif()
+    target_compile_definitions(GridToolsTestMC INTERFACE GT_MC_USE_LIBNUMA)
+    target_link_libraries(GridToolsTestMC INTERFACE ${NUMA_LIBRARY})
+  endif()
 endif( GT_ENABLE_BACKEND_MC )
 
 # TODO: Move to separate file?
@@ -167,6 +175,9 @@ endif()
 if(GT_ENABLE_PERFORMANCE_METERS)
     target_compile_definitions(GridToolsTest INTERFACE GT_ENABLE_METERS)
 endif(GT_ENABLE_PERFORMANCE_METERS)
+if(GT_ENABLE_STAGE_METERS)
+    target_compile_definitions(GridToolsTest INTERFACE GT_ENABLE_STAGE_METERS)
+endif(GT_ENABLE_STAGE_METERS)
 
 ## precision ##
 if(GT_SINGLE_PRECISION)
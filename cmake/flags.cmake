@@ -8,6 +8,7 @@ option( GT_ENABLE_BACKEND_X86 "Compile x86 backend examples and unit tests" ${OP
 option( GT_ENABLE_BACKEND_NAIVE "Compile naive backend examples and unit tests" ON)
 option( GT_ENABLE_BACKEND_MC "Compile MC backend examples and unit tests" ${OPENMP_AVAILABLE} )
 option( GT_USE_MPI "Compile with MPI support" ${MPI_AVAILABLE} )
+option( GT_ENABLE_LIBNUMA "Use libnuma for explicit NUMA placement of MC storages in examples and unit tests" OFF )
 
 # TODO remove when implementing smaller-grained test enablers
 option( GT_GCL_ONLY "If on only library is build but not the examples and tests" OFF )
@@ -20,6 +21,9 @@ CMAKE_DEPENDENT_OPTION(
 CMAKE_DEPENDENT_OPTION(
     GT_ENABLE_PERFORMANCE_METERS "If on, meters will be reported for each stencil"
     OFF "BUILD_TESTING" OFF)
+CMAKE_DEPENDENT_OPTION(
+    GT_ENABLE_STAGE_METERS "If on, the mc and x86 backends time each stage (see stage_meters.hpp)"
+    OFF "BUILD_TESTING" OFF)
 CMAKE_DEPENDENT_OPTION(
     GT_SINGLE_PRECISION "Option determining number of bytes used to represent the floating poit types (see defs.hpp for configuration)"
     OFF "BUILD_TESTING" OFF)
@@ -37,6 +37,67 @@ namespace gridtools {
         BoundaryFunction const boundary_function;
         Predicate predicate;
 
+        /** @brief a box of the halo region in one direction. Its points are numbered with i running fastest, then k,
+            then j; `begin` is the number of the first point in the flat sequence of all the regions of a sweep.
+         */
+        template <typename... DataFieldViews>
+        struct region {
+            using loop_t = void (boundary_apply::*)(region const &, int_t, int_t, DataFieldViews const &...) const;
+
+            int_t i_low;
+            int_t j_low;
+            int_t k_low;
+            int_t i_size;
+            int_t k_size;
+            int_t begin;
+            int_t size;
+            loop_t loop;
+        };
+
+        /** @brief adds the halo region of the direction to the sweep, unless it is excluded by the predicate or empty
+         */
+        template <typename Direction, typename... DataFieldViews>
+        void add_region(region<DataFieldViews...> *regions, int_t &count) const {
+            if (!predicate(Direction()))
+                return;
+            region<DataFieldViews...> res;
+            res.i_low = halo_descriptors[0].loop_low_bound_outside(Direction::i);
+            res.j_low = halo_descriptors[1].loop_low_bound_outside(Direction::j);
+            res.k_low = halo_descriptors[2].loop_low_bound_outside(Direction::k);
+            res.i_size = halo_descriptors[0].loop_high_bound_outside(Direction::i) - res.i_low + 1;
+            res.k_size = halo_descriptors[2].loop_high_bound_outside(Direction::k) - res.k_low + 1;
+            int_t j_size = halo_descriptors[1].loop_high_bound_outside(Direction::j) - res.j_low + 1;
+            if (res.i_size <= 0 || j_size <= 0 || res.k_size <= 0)
+                return;
+            res.begin = count ? regions[count - 1].begin + regions[count - 1].size : 0;
+            res.size = res.i_size * j_size * res.k_size;
+            res.loop = &boundary_apply::loop_region<Direction, DataFieldViews...>;
+            regions[count++] = res;
+        }
+
+        /** @brief evaluates the boundary_function in the specified direction on the points [first, last) of the
+            region (numbered within the region).
+         */
+        template <typename Direction, typename... DataFieldViews>
+        void loop_region(region<DataFieldViews...> const &r,
+            int_t first,
+            int_t last,
+            DataFieldViews const &... data_field_views) const {
+            int_t row = first / r.i_size;
+            int_t i_first = first % r.i_size;
+            while (first < last) {
+                const int_t j = r.j_low + row / r.k_size;
+                const int_t k = r.k_low + row % r.k_size;
+                const int_t i_last = i_first + last - first < r.i_size ? i_first + last - first : r.i_size;
+#pragma omp simd
+                for (int_t i = i_first; i < i_last; ++i)
+                    boundary_function(Direction(), data_field_views..., r.i_low + i, j, k);
+                first += i_last - i_first;
+                i_first = 0;
+                ++row;
+            }
+        }
+
         /** @brief loops on the halo region defined by the HaloDescriptor member parameter, and evaluates the
            boundary_function in the specified direction, in the specified halo node.
             this macro expands to n definitions of the function loop, taking a number of arguments ranging from 0 to n
@@ -69,6 +130,8 @@ namespace gridtools {
         possible directions.
         this macro expands to n definitions of the function apply, taking a number of arguments ranging from 0 to n
         (DataField0, Datafield1, DataField2, ...)
+        The directions are applied one after the other, each in a parallel loop of its own (see also
+        `apply_in_single_sweep`).
 
         */
         template <typename... DataFieldViews>
@@ -138,6 +201,74 @@ namespace gridtools {
             // apply(data_field_views ...);
         }
 
+        /**
+           @brief applies the boundary conditions like `apply`, in a single parallel sweep over the halo regions of all
+        the directions.
+
+        The points of the regions are numbered consecutively and every thread gets an equal share of this sequence,
+        which may span several directions. This avoids a parallel region per direction, which dominates for small
+        halos, but the directions are not applied one after the other: the boundary function must not read values it
+        writes in another direction (like it must not within a direction).
+        */
+        template <typename... DataFieldViews>
+        void apply_in_single_sweep(DataFieldViews const &... data_field_views) const {
+            region<DataFieldViews...> regions[26];
+            int_t count = 0;
+
+            add_region<direction<minus_, minus_, minus_>>(regions, count);
+            add_region<direction<minus_, minus_, zero_>>(regions, count);
+            add_region<direction<minus_, minus_, plus_>>(regions, count);
+
+            add_region<direction<minus_, zero_, minus_>>(regions, count);
+            add_region<direction<minus_, zero_, zero_>>(regions, count);
+            add_region<direction<minus_, zero_, plus_>>(regions, count);
+
+            add_region<direction<minus_, plus_, minus_>>(regions, count);
+            add_region<direction<minus_, plus_, zero_>>(regions, count);
+            add_region<direction<minus_, plus_, plus_>>(regions, count);
+
+            add_region<direction<zero_, minus_, minus_>>(regions, count);
+            add_region<direction<zero_, minus_, zero_>>(regions, count);
+            add_region<direction<zero_, minus_, plus_>>(regions, count);
+
+            add_region<direction<zero_, zero_, minus_>>(regions, count);
+            add_region<direction<zero_, zero_, plus_>>(regions, count);
+
+            add_region<direction<zero_, plus_, minus_>>(regions, count);
+            add_region<direction<zero_, plus_, zero_>>(regions, count);
+            add_region<direction<zero_, plus_, plus_>>(regions, count);
+
+            add_region<direction<plus_, minus_, minus_>>(regions, count);
+            add_region<direction<plus_, minus_, zero_>>(regions, count);
+            add_region<direction<plus_, minus_, plus_>>(regions, count);
+
+            add_region<direction<plus_, zero_, minus_>>(regions, count);
+            add_region<direction<plus_, zero_, zero_>>(regions, count);
+            add_region<direction<plus_, zero_, plus_>>(regions, count);
+
+            add_region<direction<plus_, plus_, minus_>>(regions, count);
+            add_region<direction<plus_, plus_, zero_>>(regions, count);
+            add_region<direction<plus_, plus_, plus_>>(regions, count);
+
+            if (count == 0)
+                return;
+            const int_t total = regions[count - 1].begin + regions[count - 1].size;
+            const int_t chunks = omp_get_max_threads() < total ? omp_get_max_threads() : total;
+
+#pragma omp parallel for schedule(static)
+            for (int_t chunk = 0; chunk < chunks; ++chunk) {
+                const int_t first = static_cast<int_t>(static_cast<long long>(total) * chunk / chunks);
+                const int_t last = static_cast<int_t>(static_cast<long long>(total) * (chunk + 1) / chunks);
+                for (int_t r = 0; r < count; ++r) {
+                    region<DataFieldViews...> const &current = regions[r];
+                    const int_t region_first = first > current.begin ? first - current.begin : 0;
+                    const int_t region_last = last - current.begin < current.size ? last - current.begin : current.size;
+                    if (region_first < region_last)
+                        (this->*current.loop)(current, region_first, region_last, data_field_views...);
+                }
+            }
+        }
+
       private:
         /** fixing compilation */
         void apply() const {}
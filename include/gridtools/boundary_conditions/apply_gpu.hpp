@@ -342,6 +342,14 @@ namespace gridtools {
             GT_CUDA_CHECK(cudaGetLastError());
 #endif
         }
+
+        /**
+           @brief same as `apply`, the kernel already covers all the directions in a single launch.
+        */
+        template <typename... DataFieldViews>
+        void apply_in_single_sweep(DataFieldViews const &... data_field_views) const {
+            apply(data_field_views...);
+        }
     };
 
     /** @} */
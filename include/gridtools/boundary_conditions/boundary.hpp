@@ -88,6 +88,17 @@ namespace gridtools {
                 _impl::proper_view<Arch, access_mode::read_write, typename std::decay<DataFields>::type>::make(
                     data_fields)...);
         }
+
+        /**
+           @brief Like `apply`, with the halo regions of all directions processed in a single parallel loop, in no
+           particular order (see `boundary_apply::apply_in_single_sweep`).
+         */
+        template <typename... DataFields>
+        void apply_in_single_sweep(DataFields &... data_fields) const {
+            bc_apply.apply_in_single_sweep(
+                _impl::proper_view<Arch, access_mode::read_write, typename std::decay<DataFields>::type>::make(
+                    data_fields)...);
+        }
     };
 
     /** @} */
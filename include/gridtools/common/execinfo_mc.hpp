@@ -10,8 +10,24 @@
 
 #pragma once
 
-#include "../../../common/defs.hpp"
-#include "../../../common/host_device.hpp"
+#include <cassert>
+
+#include <omp.h>
+
+#include "defs.hpp"
+#include "host_device.hpp"
+
+/**
+ * Number of blocks per thread the domain is split into when the work-stealing scheduler is used (enabled by defining
+ * GT_MC_WORK_STEALING). Oversubscription allows idle threads to take over work of slow threads.
+ */
+#ifndef GT_MC_BLOCKS_PER_THREAD
+#ifdef GT_MC_WORK_STEALING
+#define GT_MC_BLOCKS_PER_THREAD 8
+#else
+#define GT_MC_BLOCKS_PER_THREAD 1
+#endif
+#endif
 
 namespace gridtools {
 
@@ -51,20 +67,34 @@ namespace gridtools {
             : m_i_grid_size(grid.i_high_bound() - grid.i_low_bound() + 1),
               m_j_grid_size(grid.j_high_bound() - grid.j_low_bound() + 1), m_i_low_bound(grid.i_low_bound()),
               m_j_low_bound(grid.j_low_bound()) {
-            const int_t threads = omp_get_max_threads();
+            const int_t blocks = omp_get_max_threads() * GT_MC_BLOCKS_PER_THREAD;
 
-            // if domain is large enough (relative to the number of threads),
+            // if domain is large enough (relative to the number of blocks),
             // we split only along j-axis (for prefetching reasons)
             // for smaller domains we also split along i-axis
-            m_j_block_size = (m_j_grid_size + threads - 1) / threads;
+            m_j_block_size = (m_j_grid_size + blocks - 1) / blocks;
             m_j_blocks = (m_j_grid_size + m_j_block_size - 1) / m_j_block_size;
-            const int_t max_i_blocks = threads / m_j_blocks;
+            const int_t max_i_blocks = blocks / m_j_blocks;
             m_i_block_size = (m_i_grid_size + max_i_blocks - 1) / max_i_blocks;
             m_i_blocks = (m_i_grid_size + m_i_block_size - 1) / m_i_block_size;
 
             assert(m_i_block_size > 0 && m_j_block_size > 0);
         }
 
+        /**
+         * @brief Uses the given block sizes instead of the default heuristic. Must not exceed the default block sizes,
+         * as temporaries are allocated for those.
+         */
+        template <class Grid>
+        GT_FUNCTION execinfo_mc(const Grid &grid, int_t i_block_size, int_t j_block_size)
+            : m_i_grid_size(grid.i_high_bound() - grid.i_low_bound() + 1),
+              m_j_grid_size(grid.j_high_bound() - grid.j_low_bound() + 1), m_i_low_bound(grid.i_low_bound()),
+              m_j_low_bound(grid.j_low_bound()), m_i_block_size(i_block_size), m_j_block_size(j_block_size),
+              m_i_blocks((m_i_grid_size + i_block_size - 1) / i_block_size),
+              m_j_blocks((m_j_grid_size + j_block_size - 1) / j_block_size) {
+            assert(m_i_block_size > 0 && m_j_block_size > 0);
+        }
+
         /**
          * @brief Computes the effective (clamped) block size and position for k-serial stencils.
          *
@@ -12,28 +12,189 @@
 
 #include <atomic>
 #include <cstdlib>
+#include <fstream>
 #include <new>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/**@file
+ * @brief Allocation of large, huge page backed buffers.
+ *
+ * The way huge pages are requested is selected at runtime with `hugepage_configuration().mode`. The default mode can be
+ * set by defining GT_HUGEPAGE_MODE to one of the values of `hugepage_mode`, e.g. `-DGT_HUGEPAGE_MODE=hugetlbfs`. If
+ * GT_NO_HUGETLB is defined, the default is `hugepage_mode::none`.
+ */
+
+#ifndef GT_HUGEPAGE_MODE
+#ifdef GT_NO_HUGETLB
+#define GT_HUGEPAGE_MODE none
+#else
+#define GT_HUGEPAGE_MODE transparent
+#endif
+#endif
 
 namespace gridtools {
 
+    enum class hugepage_mode {
+        /** 2MB aligned allocation, whether huge pages are used depends on the system wide THP setting */
+        none,
+        /** like none, but transparent huge pages are explicitly requested with madvise(MADV_HUGEPAGE) */
+        transparent,
+        /** pages from the pool of the hugetlbfs (mmap with MAP_HUGETLB), falls back to transparent */
+        hugetlbfs
+    };
+
+    struct hugepage_config {
+        hugepage_mode mode = hugepage_mode::GT_HUGEPAGE_MODE;
+        /**
+         * Consecutive allocations are shifted by an offset that doubles from `min_offset` to `max_offset` and then
+         * starts again at `min_offset`, to reduce the risk of cache set conflicts. The offsets are rounded up to
+         * multiples of 64 bytes; set both to the same value to disable the rotation.
+         */
+        std::size_t min_offset = 64;
+        std::size_t max_offset = 4096;
+    };
+
     /**
-     * @brief Allocates huge page memory (if GT_NO_HUGETLB is not defined) and shifts allocations by some bytes to
-     * reduce cache set conflicts.
+     * @brief Bytes currently allocated by hugepage_alloc.
      */
-    inline void *hugepage_alloc(std::size_t size) {
-        static std::atomic<std::size_t> s_offset(64);
-        auto offset = s_offset.load(std::memory_order_relaxed);
-        auto next_offset = offset;
-        while (!s_offset.compare_exchange_weak(
-            next_offset, 2 * next_offset <= 4096 ? 2 * next_offset : 64, std::memory_order_relaxed)) {
+    struct hugepage_stats {
+        /** all allocations */
+        std::size_t total_bytes;
+        /** allocations backed by hugetlbfs pages */
+        std::size_t hugetlb_bytes;
+        /** allocations advised to use transparent huge pages */
+        std::size_t transparent_bytes;
+    };
+
+    namespace _impl_hugepage_alloc {
+        constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+        enum class kind : std::size_t { plain, transparent, hugetlb };
+
+        // stored in front of each allocation, must fit into the minimal offset
+        struct header {
+            std::size_t size;
+            std::size_t mapped_size;
+            kind backing;
+            std::size_t offset;
+        };
+        static_assert(sizeof(header) <= 64, "");
+
+        struct counters {
+            std::atomic<std::size_t> total{0};
+            std::atomic<std::size_t> hugetlb{0};
+            std::atomic<std::size_t> transparent{0};
+        };
+
+        inline counters &get_counters() {
+            static counters s_counters;
+            return s_counters;
+        }
+
+        inline std::size_t round_up(std::size_t size, std::size_t alignment) {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        inline std::size_t next_offset(hugepage_config const &config) {
+            static std::atomic<std::size_t> s_offset(0);
+            std::size_t min_offset = round_up(config.min_offset ? config.min_offset : 1, 64);
+            std::size_t max_offset = round_up(config.max_offset, 64);
+            auto offset = s_offset.load(std::memory_order_relaxed);
+            std::size_t current, next;
+            do {
+                current = offset >= min_offset && offset <= max_offset ? offset : min_offset;
+                next = 2 * current <= max_offset ? 2 * current : min_offset;
+            } while (!s_offset.compare_exchange_weak(offset, next, std::memory_order_relaxed));
+            return current;
+        }
+
+#ifdef __linux__
+        inline void *map_hugetlb(std::size_t size) {
+            void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            return ptr == MAP_FAILED ? nullptr : ptr;
         }
+#endif
+    } // namespace _impl_hugepage_alloc
 
-        void *ptr;
-        if (posix_memalign(&ptr, 2 * 1024 * 1024, size + offset))
+    /**
+     * @brief Process-wide configuration of hugepage_alloc, changes only affect future allocations.
+     */
+    inline hugepage_config &hugepage_configuration() {
+        static hugepage_config s_config;
+        return s_config;
+    }
+
+    inline hugepage_stats hugepage_statistics() {
+        auto const &counters = _impl_hugepage_alloc::get_counters();
+        return {counters.total.load(), counters.hugetlb.load(), counters.transparent.load()};
+    }
+
+    /**
+     * @brief Number of bytes of the process that are currently backed by huge pages, as reported by the kernel
+     * (transparent and hugetlbfs pages of all allocations, not only of hugepage_alloc). Returns 0 if unknown.
+     */
+    inline std::size_t hugepage_resident_bytes() {
+        std::ifstream smaps("/proc/self/smaps_rollup");
+        std::size_t result = 0;
+        std::string line;
+        while (std::getline(smaps, line)) {
+            if (line.compare(0, 14, "AnonHugePages:") && line.compare(0, 15, "Shared_Hugetlb:") &&
+                line.compare(0, 16, "Private_Hugetlb:"))
+                continue;
+            std::istringstream fields(line.substr(line.find(':') + 1));
+            std::size_t kilobytes = 0;
+            fields >> kilobytes;
+            result += kilobytes * 1024;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Allocates huge page memory (as configured by hugepage_configuration()) and shifts allocations by some
+     * bytes to reduce cache set conflicts.
+     */
+    inline void *hugepage_alloc(std::size_t size) {
+        using namespace _impl_hugepage_alloc;
+        auto const &config = hugepage_configuration();
+        std::size_t offset = next_offset(config);
+
+        header h = {size, 0, kind::plain, offset};
+        void *base = nullptr;
+#ifdef __linux__
+        // allocations smaller than a huge page are not worth a huge page
+        bool large = size + offset >= huge_page_size;
+        if (large && config.mode == hugepage_mode::hugetlbfs) {
+            h.mapped_size = round_up(size + offset, huge_page_size);
+            base = map_hugetlb(h.mapped_size);
+            if (base)
+                h.backing = kind::hugetlb;
+            else
+                h.mapped_size = 0;
+        }
+#endif
+        if (!base && posix_memalign(&base, huge_page_size, size + offset))
             throw std::bad_alloc();
+#ifdef __linux__
+        if (large && h.backing == kind::plain && config.mode != hugepage_mode::none) {
+            if (madvise(base, size + offset, MADV_HUGEPAGE) == 0)
+                h.backing = kind::transparent;
+        }
+#endif
 
-        ptr = static_cast<char *>(ptr) + offset;
-        static_cast<std::size_t *>(ptr)[-1] = offset;
+        auto &counters = get_counters();
+        counters.total += size;
+        if (h.backing == kind::hugetlb)
+            counters.hugetlb += size;
+        else if (h.backing == kind::transparent)
+            counters.transparent += size;
+
+        void *ptr = static_cast<char *>(base) + offset;
+        static_cast<header *>(ptr)[-1] = h;
         return ptr;
     }
 
@@ -41,11 +202,26 @@ namespace gridtools {
      * @brief Frees memory allocated by hugepage_alloc.
      */
     inline void hugepage_free(void *ptr) {
+        using namespace _impl_hugepage_alloc;
         if (!ptr)
             return;
-        std::size_t offset = static_cast<std::size_t *>(ptr)[-1];
-        ptr = static_cast<char *>(ptr) - offset;
-        free(ptr);
+        header h = static_cast<header *>(ptr)[-1];
+        void *base = static_cast<char *>(ptr) - h.offset;
+
+        auto &counters = get_counters();
+        counters.total -= h.size;
+        if (h.backing == kind::hugetlb)
+            counters.hugetlb -= h.size;
+        else if (h.backing == kind::transparent)
+            counters.transparent -= h.size;
+
+#ifdef __linux__
+        if (h.backing == kind::hugetlb) {
+            munmap(base, h.mapped_size);
+            return;
+        }
+#endif
+        free(base);
     }
 
 } // namespace gridtools
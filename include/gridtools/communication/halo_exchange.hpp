@@ -19,6 +19,7 @@
 #include "high_level/descriptors_manual_gpu.hpp"
 
 #include "high_level/field_on_the_fly.hpp"
+#include "high_level/halo_exchange_session.hpp"
 
 namespace gridtools {
 
@@ -204,6 +205,12 @@ namespace gridtools {
         */
         typedef Halo_Exchange_3D<grid_type> pattern_type;
 
+        /**
+           Type of the sessions that aggregate the exchanges of fields with different halos in a single message per
+           neighbor (see halo_exchange_session), to be constructed with `pattern().proc_grid()`. Host fields only.
+        */
+        typedef halo_exchange_session<DataType, layout_map, layout2proc_map> session_type;
+
       private:
         template <typename Array>
         MPI_Comm _make_comm(MPI_Comm comm, Array dims) {
@@ -274,6 +281,40 @@ namespace gridtools {
         */
         pattern_type const &pattern() const { return hd.pattern(); }
 
+        /**
+           Function to select whether the halos are packed into buffers or transferred directly from and to the data
+           fields with MPI derived datatypes (see halo_transfer_mode). Only available on the host, must be called
+           before setup().
+
+           \param[in] mode The transfer mode, the default is given by GT_HALO_TRANSFER_MODE
+        */
+        void set_transfer_mode(halo_transfer_mode mode) { hd.set_transfer_mode(mode); }
+
+        halo_transfer_mode transfer_mode() const { return hd.transfer_mode(); }
+
+        /**
+           Function to select whether the messages are sent and received with persistent MPI requests, which are
+           initialized once and restarted at every exchange. Must not be called during an exchange.
+
+           \param[in] persistent Whether to use persistent requests, the default is true if
+           GT_HALO_PERSISTENT_REQUESTS is defined and false otherwise
+        */
+        void set_persistent_requests(bool persistent) { hd.set_persistent_requests(persistent); }
+
+        bool persistent_requests() const { return hd.pattern().persistent_requests(); }
+
+        /**
+           Function to select whether the received data is unpacked as it arrives, by the OpenMP threads, while the
+           other messages are still in flight. In this mode wait() returns immediately and unpack() completes the
+           exchange. Only available on the host.
+
+           \param[in] unpack_on_arrival Whether to unpack on arrival, the default is true if GT_HALO_UNPACK_ON_ARRIVAL
+           is defined and false otherwise
+        */
+        void set_unpack_on_arrival(bool unpack_on_arrival) { hd.set_unpack_on_arrival(unpack_on_arrival); }
+
+        bool unpack_on_arrival() const { return hd.unpack_on_arrival(); }
+
         /**
            Function to setup internal data structures for data exchange and preparing eventual underlying layers
 
@@ -339,7 +380,19 @@ namespace gridtools {
         */
         template <typename... FIELDS>
         void unpack(FIELDS *... _fields) {
+#ifdef GCL_TRACE
+            double start_time = MPI_Wtime();
+#endif
             hd.unpack(_fields...);
+#ifdef GCL_TRACE
+#ifdef __CUDACC__
+            GT_CUDA_CHECK(cudaDeviceSynchronize());
+#endif
+            double end_time = MPI_Wtime();
+            const ExchangeEventType type = hd.unpack_on_arrival() ? ee_wait_unpack : ee_unpack;
+            stats_collector<DIMS>::instance()->add_event(
+                ExchangeEvent(type, start_time, end_time, sizeof...(_fields), pattern_tag));
+#endif
         }
 
         /**
@@ -377,8 +430,9 @@ namespace gridtools {
             GT_CUDA_CHECK(cudaDeviceSynchronize());
 #endif
             double end_time = MPI_Wtime();
+            const ExchangeEventType type = hd.unpack_on_arrival() ? ee_wait_unpack : ee_unpack;
             stats_collector<DIMS>::instance()->add_event(
-                ExchangeEvent(ee_unpack, start_time, end_time, fields.size(), pattern_tag));
+                ExchangeEvent(type, start_time, end_time, fields.size(), pattern_tag));
 #endif
         }
 
@@ -525,6 +579,12 @@ namespace gridtools {
 
         explicit halo_exchange_generic_base(grid_type const &g) : hd(g) {}
 
+        /**
+           Function to select whether the messages are sent and received with persistent MPI requests, which are
+           initialized once and restarted at every exchange. Must not be called during an exchange.
+        */
+        void set_persistent_requests(bool persistent) { hd.set_persistent_requests(persistent); }
+
         // halo_exchange_generic(halo_exchange_generic const &src)
         //   :
         // {}
@@ -67,6 +67,12 @@ namespace gridtools {
         */
         void wait() { m_haloexch.wait(); }
 
+        /**
+           function to select whether the Level 3 pattern uses persistent MPI requests, see
+           Halo_Exchange_3D::set_persistent_requests.
+        */
+        void set_persistent_requests(bool persistent) { m_haloexch.set_persistent_requests(persistent); }
+
         /**
            Retrieve the pattern from which the computing grid and other information
            can be retrieved. The function is available only if the underlying
@@ -25,6 +25,7 @@
 #include "descriptors_fwd.hpp"
 #include "empty_field_base.hpp"
 #include "gcl_parameters.hpp"
+#include "halo_datatypes.hpp"
 #include "helpers_impl.hpp"
 #include <boost/preprocessor/arithmetic/inc.hpp>
 #include <boost/preprocessor/punctuation/comma_if.hpp>
@@ -432,6 +433,13 @@ namespace gridtools {
         gridtools::array<DataType *, _impl::static_pow3<DIMS>::value> recv_buffer;
         array<int, _impl::static_pow3<DIMS>::value> send_size;
         array<int, _impl::static_pow3<DIMS>::value> recv_size;
+        _impl::halo_datatypes<DataType> m_datatypes;
+        bool m_datatype_receives_pending = false;
+#ifdef GT_HALO_UNPACK_ON_ARRIVAL
+        bool m_unpack_on_arrival = true;
+#else
+        bool m_unpack_on_arrival = false;
+#endif
 
       public:
         typedef gcl_cpu arch_type;
@@ -495,30 +503,94 @@ namespace gridtools {
 
            \param max_fields_n Maximum number of data fields that will be passed to the communication functions
         */
-        void setup(int max_fields_n) { _impl::allocation_service<this_type>()(this, max_fields_n); }
+        void setup(int max_fields_n) {
+            _impl::allocation_service<this_type>()(this, max_fields_n);
+            m_datatypes.setup(halo.halos);
+        }
+
+        /**
+           Function to select how the halos are transferred, must be called before setup()
+        */
+        void set_transfer_mode(halo_transfer_mode mode) { m_datatypes.set_mode(mode); }
+
+        halo_transfer_mode transfer_mode() const { return m_datatypes.mode(); }
+
+        /**
+           Function to select whether the received data is unpacked as it arrives. In this mode wait() returns
+           immediately and unpack() waits for the messages itself: the calling thread completes the receives in order
+           of arrival while the other OpenMP threads unpack the faces that have already arrived. Only the calling
+           thread makes MPI calls. Must not be changed between wait() and unpack().
+
+           \param[in] unpack_on_arrival Whether to unpack on arrival, the default is true if GT_HALO_UNPACK_ON_ARRIVAL
+           is defined and false otherwise
+        */
+        void set_unpack_on_arrival(bool unpack_on_arrival) { m_unpack_on_arrival = unpack_on_arrival; }
+
+        bool unpack_on_arrival() const { return m_unpack_on_arrival; }
 
 #ifdef GCL_TRACE
         void set_pattern_tag(int tag) { base_type::m_haloexch.set_pattern_tag(tag); };
 #endif
 
         /**
-           Function to pack data to be sent
+           Function to post the receives before pack(). The receives of the directions transferred with datatypes are
+           posted by pack(), since the fields to receive into are not known yet.
+        */
+        void post_receives() {
+            if (m_datatypes.any()) {
+                for_each_neighbor([this](array<int, 3> const &eta, int ii_P, int jj_P, int kk_P) {
+                    if (m_datatypes.receives(eta))
+                        base_type::m_haloexch.set_receive_from_size(0, ii_P, jj_P, kk_P);
+                });
+                m_datatype_receives_pending = true;
+            }
+            base_type::post_receives();
+        }
+
+        /**
+           Function to pack data to be sent. The directions transferred with MPI datatypes are not copied, their data
+           is sent from and received into these fields, so the same fields must be passed to unpack.
 
            \param[in] _fields data fields to be packed
         */
         template <typename... FIELDS>
         void pack(const FIELDS &... _fields) {
+            register_datatypes({const_cast<void *>(static_cast<void const *>(_fields))...});
             pack_dims<DIMS, 0>()(*this, _fields...);
         }
 
+        /**
+           function to exchange the data, only started when unpacking on arrival, unpack() completes it
+        */
+        void exchange() {
+            if (m_unpack_on_arrival)
+                base_type::start_exchange();
+            else
+                base_type::exchange();
+        }
+
+        /**
+           function to wait for the data exchange to complete, deferred to unpack() when unpacking on arrival
+        */
+        void wait() {
+            if (!m_unpack_on_arrival)
+                base_type::wait();
+        }
+
         /**
            Function to unpack received data
 
            \param[in] _fields data fields where to unpack data
         */
         template <typename... FIELDS>
-        void unpack(const FIELDS &... _fields) const {
-            unpack_dims<DIMS, 0>()(*this, _fields...);
+        void unpack(const FIELDS &... _fields) {
+            if (m_unpack_on_arrival)
+                wait_and_unpack([&](array<int, 3> const &eta) {
+                    DataType *it = &(recv_buffer[translate()(eta[0], eta[1], eta[2])][0]);
+                    halo.unpack_all(eta, it, _fields...);
+                });
+            else
+                unpack_dims<DIMS, 0>()(*this, _fields...);
         }
 
         /**
@@ -526,14 +598,26 @@ namespace gridtools {
 
            \param[in] fields vector with data fields pointers to be packed from
         */
-        void pack(std::vector<DataType *> const &fields) { pack_vector_dims<DIMS, 0>()(*this, fields); }
+        void pack(std::vector<DataType *> const &fields) {
+            register_datatypes(std::vector<void *>(fields.begin(), fields.end()));
+            pack_vector_dims<DIMS, 0>()(*this, fields);
+        }
 
         /**
            Function to unpack received data
 
            \param[in] fields vector with data fields pointers to be unpacked into
         */
-        void unpack(std::vector<DataType *> const &fields) { unpack_vector_dims<DIMS, 0>()(*this, fields); }
+        void unpack(std::vector<DataType *> const &fields) {
+            if (m_unpack_on_arrival)
+                wait_and_unpack([&](array<int, 3> const &eta) {
+                    DataType *it = &(recv_buffer[translate()(eta[0], eta[1], eta[2])][0]);
+                    for (size_t i = 0; i < fields.size(); ++i)
+                        halo.unpack(eta, fields[i], it);
+                });
+            else
+                unpack_vector_dims<DIMS, 0>()(*this, fields);
+        }
 
         /// Utilities
 
@@ -554,6 +638,83 @@ namespace gridtools {
         // friend class _impl::unpack_service<this_type>;
 
       private:
+        /**
+           Registers the datatypes of the fields with the pattern for the directions that are not packed.
+        */
+        void register_datatypes(std::vector<void *> const &fields) {
+            if (!m_datatypes.any())
+                return;
+            m_datatypes.set_fields(fields);
+            for_each_neighbor([this](array<int, 3> const &eta, int ii_P, int jj_P, int kk_P) {
+                if (m_datatypes.sends(eta))
+                    base_type::m_haloexch.register_send_to_datatype(
+                        MPI_BOTTOM, m_datatypes.send_type(eta), ii_P, jj_P, kk_P);
+                if (m_datatypes.receives(eta)) {
+                    base_type::m_haloexch.register_receive_from_datatype(
+                        MPI_BOTTOM, m_datatypes.recv_type(eta), ii_P, jj_P, kk_P);
+                    if (m_datatype_receives_pending)
+                        base_type::m_haloexch.post_receive_from(ii_P, jj_P, kk_P);
+                }
+            });
+            m_datatype_receives_pending = false;
+        }
+
+        /**
+           Completes the exchange and calls unpack_face(eta) for every packed face as soon as it has arrived. The
+           master thread waits for the messages and hands the faces over to the other threads as tasks. The faces
+           whose messages were already completed (e.g. by a previous wait()) are unpacked at the end.
+        */
+        template <class F>
+        void wait_and_unpack(F const &unpack_face) {
+#pragma omp parallel
+            {
+#pragma omp master
+                {
+                    bool unpacked[_impl::static_pow3<DIMS>::value] = {};
+                    base_type::m_haloexch.wait_each([&](int ii_P, int jj_P, int kk_P) {
+                        typedef proc_layout map_type;
+                        array<int, 3> eta;
+                        eta[map_type::template at<0>()] = ii_P;
+                        eta[map_type::template at<1>()] = jj_P;
+                        eta[map_type::template at<2>()] = kk_P;
+                        unpacked[translate()(eta[0], eta[1], eta[2])] = true;
+                        if (!m_datatypes.receives(eta)) {
+#pragma omp task firstprivate(eta)
+                            unpack_face(eta);
+                        }
+                    });
+                    for_each_neighbor([&](array<int, 3> const &eta, int, int, int) {
+                        if (!unpacked[translate()(eta[0], eta[1], eta[2])] && !m_datatypes.receives(eta)) {
+                            array<int, 3> face = eta;
+#pragma omp task firstprivate(face)
+                            unpack_face(face);
+                        }
+                    });
+                }
+            }
+        }
+
+        /**
+           Calls f(eta, ii_P, jj_P, kk_P) for all existing neighbors, with the coordinates relative to the halo (eta)
+           and to the process grid.
+        */
+        template <class F>
+        void for_each_neighbor(F const &f) const {
+            for (int ii = -1; ii <= 1; ++ii) {
+                for (int jj = -1; jj <= 1; ++jj) {
+                    for (int kk = -1; kk <= 1; ++kk) {
+                        typedef proc_layout map_type;
+                        const auto eta = make_array(ii, jj, kk);
+                        const int ii_P = eta[map_type::template at<0>()];
+                        const int jj_P = eta[map_type::template at<1>()];
+                        const int kk_P = eta[map_type::template at<2>()];
+                        if ((ii != 0 || jj != 0 || kk != 0) && pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)
+                            f(eta, ii_P, jj_P, kk_P);
+                    }
+                }
+            }
+        }
+
         template <int I, int dummy>
         struct pack_dims {};
 
@@ -571,19 +732,22 @@ namespace gridtools {
                             const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
                             if ((ii != 0 || jj != 0 || kk != 0) &&
                                 (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                                DataType *it = &(hm.send_buffer[translate()(ii, jj, kk)][0]);
-                                hm.halo.pack_all(make_array(ii, jj, kk), it, _fields...);
-
-                                hm.m_haloexch.set_send_to_size(
-                                    hm.send_size[translate()(ii, jj, kk)] * sizeof...(_fields) * sizeof(DataType),
-                                    ii_P,
-                                    jj_P,
-                                    kk_P);
-                                hm.m_haloexch.set_receive_from_size(
-                                    hm.recv_size[translate()(ii, jj, kk)] * sizeof...(_fields) * sizeof(DataType),
-                                    ii_P,
-                                    jj_P,
-                                    kk_P);
+                                if (!hm.m_datatypes.sends(make_array(ii, jj, kk))) {
+                                    DataType *it = &(hm.send_buffer[translate()(ii, jj, kk)][0]);
+                                    hm.halo.pack_all(make_array(ii, jj, kk), it, _fields...);
+
+                                    hm.m_haloexch.set_send_to_size(
+                                        hm.send_size[translate()(ii, jj, kk)] * sizeof...(_fields) * sizeof(DataType),
+                                        ii_P,
+                                        jj_P,
+                                        kk_P);
+                                }
+                                if (!hm.m_datatypes.receives(make_array(ii, jj, kk)))
+                                    hm.m_haloexch.set_receive_from_size(
+                                        hm.recv_size[translate()(ii, jj, kk)] * sizeof...(_fields) * sizeof(DataType),
+                                        ii_P,
+                                        jj_P,
+                                        kk_P);
                             }
                         }
                     }
@@ -607,7 +771,8 @@ namespace gridtools {
                             const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
                             const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
                             if ((ii != 0 || jj != 0 || kk != 0) &&
-                                (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
+                                (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1) &&
+                                !hm.m_datatypes.receives(make_array(ii, jj, kk))) {
                                 DataType *it = &(hm.recv_buffer[translate()(ii, jj, kk)][0]);
                                 hm.halo.unpack_all(make_array(ii, jj, kk), it, _fields...);
                             }
@@ -634,21 +799,24 @@ namespace gridtools {
                             const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
                             if ((ii != 0 || jj != 0 || kk != 0) &&
                                 (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                                DataType *it = &(hm.send_buffer[translate()(ii, jj, kk)][0]);
-                                for (size_t i = 0; i < fields.size(); ++i) {
-                                    hm.halo.pack(make_array(ii, jj, kk), fields[i], it);
+                                if (!hm.m_datatypes.sends(make_array(ii, jj, kk))) {
+                                    DataType *it = &(hm.send_buffer[translate()(ii, jj, kk)][0]);
+                                    for (size_t i = 0; i < fields.size(); ++i) {
+                                        hm.halo.pack(make_array(ii, jj, kk), fields[i], it);
+                                    }
+
+                                    hm.m_haloexch.set_send_to_size(
+                                        hm.send_size[translate()(ii, jj, kk)] * fields.size() * sizeof(DataType),
+                                        ii_P,
+                                        jj_P,
+                                        kk_P);
                                 }
-
-                                hm.m_haloexch.set_send_to_size(
-                                    hm.send_size[translate()(ii, jj, kk)] * fields.size() * sizeof(DataType),
-                                    ii_P,
-                                    jj_P,
-                                    kk_P);
-                                hm.m_haloexch.set_receive_from_size(
-                                    hm.recv_size[translate()(ii, jj, kk)] * fields.size() * sizeof(DataType),
-                                    ii_P,
-                                    jj_P,
-                                    kk_P);
+                                if (!hm.m_datatypes.receives(make_array(ii, jj, kk)))
+                                    hm.m_haloexch.set_receive_from_size(
+                                        hm.recv_size[translate()(ii, jj, kk)] * fields.size() * sizeof(DataType),
+                                        ii_P,
+                                        jj_P,
+                                        kk_P);
                             }
                         }
                     }
@@ -672,7 +840,8 @@ namespace gridtools {
                             const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
                             const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
                             if ((ii != 0 || jj != 0 || kk != 0) &&
-                                (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
+                                (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1) &&
+                                !hm.m_datatypes.receives(make_array(ii, jj, kk))) {
                                 DataType *it = &(hm.recv_buffer[translate()(ii, jj, kk)][0]);
                                 for (size_t i = 0; i < fields.size(); ++i) {
                                     hm.halo.unpack(make_array(ii, jj, kk), fields[i], it);
@@ -129,6 +129,12 @@ namespace gridtools {
 #ifdef GCL_TRACE
         void set_pattern_tag(int tag) { base_type::m_haloexch.set_pattern_tag(tag); };
 #endif
+
+        /**
+           The received data is unpacked after wait() on the device, unpacking on arrival is only available on the host
+        */
+        bool unpack_on_arrival() const { return false; }
+
         /**
            Constructor
 
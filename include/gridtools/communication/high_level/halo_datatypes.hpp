@@ -0,0 +1,210 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <vector>
+
+#include <mpi.h>
+
+#include "../../common/array.hpp"
+#include "../../common/halo_descriptor.hpp"
+#include "empty_field_base.hpp"
+
+/** @file
+    The default transfer mode of halo_exchange_dynamic_ut on the host can be set by defining GT_HALO_TRANSFER_MODE to
+    one of the values of halo_transfer_mode, e.g. `-DGT_HALO_TRANSFER_MODE=automatic`. In automatic mode, MPI derived
+    datatypes are used for the directions whose halos are made of contiguous blocks of at least
+    GT_HALO_DATATYPE_MIN_BLOCK bytes.
+*/
+
+#ifndef GT_HALO_TRANSFER_MODE
+#define GT_HALO_TRANSFER_MODE packed
+#endif
+
+#ifndef GT_HALO_DATATYPE_MIN_BLOCK
+#define GT_HALO_DATATYPE_MIN_BLOCK 64
+#endif
+
+namespace gridtools {
+
+    /**
+       How the halos of a direction are transferred by halo_exchange_dynamic_ut.
+    */
+    enum class halo_transfer_mode {
+        /** halos are packed into buffers, sent and unpacked */
+        packed,
+        /** halos are sent from and received into the fields using MPI derived datatypes, pack and unpack do not copy */
+        datatype,
+        /** datatype for the directions with long contiguous blocks in memory, packed for the others */
+        automatic
+    };
+
+    namespace _impl {
+        /**
+           MPI derived datatypes describing the halos of a list of fields, one per direction.
+
+           The subarray types of the halo regions of a single field are created once by setup(). The types covering all
+           the fields (an hindexed block of the subarray type, with absolute addresses) are created when the list of
+           fields changes, so they are reused as long as the same fields are exchanged.
+        */
+        template <typename DataType>
+        class halo_datatypes {
+            static constexpr int DIMS = 3;
+            typedef array<MPI_Datatype, _impl::static_pow3<DIMS>::value> types_t;
+
+            halo_transfer_mode m_mode = halo_transfer_mode::GT_HALO_TRANSFER_MODE;
+            types_t m_send_region;
+            types_t m_recv_region;
+            types_t m_send;
+            types_t m_recv;
+            std::vector<void *> m_fields;
+
+            static void free_types(types_t &types) {
+                int finalized;
+                MPI_Finalized(&finalized);
+                for (auto &type : types) {
+                    if (type != MPI_DATATYPE_NULL && !finalized)
+                        MPI_Type_free(&type);
+                    type = MPI_DATATYPE_NULL;
+                }
+            }
+
+            /**
+               Bytes of the contiguous blocks of memory of the region sent to (inside) or received from (outside) the
+               neighbor eta, dimension 0 has stride 1.
+            */
+            template <typename Halos>
+            static int block_bytes(Halos const &halos, array<int, DIMS> const &eta, bool inside) {
+                int block = sizeof(DataType);
+                for (int i = 0; i < DIMS; ++i) {
+                    int length =
+                        inside ? halos[i].loop_high_bound_inside(eta[i]) - halos[i].loop_low_bound_inside(eta[i]) + 1
+                               : halos[i].loop_high_bound_outside(eta[i]) - halos[i].loop_low_bound_outside(eta[i]) + 1;
+                    block *= length;
+                    if (length != (int)halos[i].total_length())
+                        break;
+                }
+                return block;
+            }
+
+            // the decision only depends on the shape of the region, so that it is the same on both ends of a message
+            template <typename Halos>
+            bool use_datatype(Halos const &halos, array<int, DIMS> const &eta, bool inside) const {
+                switch (m_mode) {
+                case halo_transfer_mode::datatype:
+                    return true;
+                case halo_transfer_mode::automatic:
+                    return block_bytes(halos, eta, inside) >= GT_HALO_DATATYPE_MIN_BLOCK;
+                default:
+                    return false;
+                }
+            }
+
+            static MPI_Datatype all_fields(MPI_Datatype region, std::vector<void *> const &fields) {
+                std::vector<MPI_Aint> addresses(fields.size());
+                for (std::size_t i = 0; i < fields.size(); ++i)
+                    MPI_Get_address(fields[i], &addresses[i]);
+                MPI_Datatype result;
+                MPI_Type_create_hindexed_block(fields.size(), 1, addresses.data(), region, &result);
+                MPI_Type_commit(&result);
+                return result;
+            }
+
+          public:
+            halo_datatypes() {
+                for (int i = 0; i < _impl::static_pow3<DIMS>::value; ++i) {
+                    m_send_region[i] = MPI_DATATYPE_NULL;
+                    m_recv_region[i] = MPI_DATATYPE_NULL;
+                    m_send[i] = MPI_DATATYPE_NULL;
+                    m_recv[i] = MPI_DATATYPE_NULL;
+                }
+            }
+
+            halo_datatypes(halo_datatypes const &) = delete;
+            halo_datatypes &operator=(halo_datatypes const &) = delete;
+
+            ~halo_datatypes() {
+                free_types(m_send);
+                free_types(m_recv);
+                free_types(m_send_region);
+                free_types(m_recv_region);
+            }
+
+            halo_transfer_mode mode() const { return m_mode; }
+            void set_mode(halo_transfer_mode mode) { m_mode = mode; }
+
+            /**
+               Creates the subarray types of the directions that are transferred with datatypes. Empty regions are
+               always packed (which means they are not sent at all).
+            */
+            template <typename Halos>
+            void setup(Halos const &halos) {
+                free_types(m_send);
+                free_types(m_recv);
+                free_types(m_send_region);
+                free_types(m_recv_region);
+                m_fields.clear();
+                for (int ii = -1; ii <= 1; ++ii)
+                    for (int jj = -1; jj <= 1; ++jj)
+                        for (int kk = -1; kk <= 1; ++kk) {
+                            array<int, DIMS> eta{ii, jj, kk};
+                            if (ii == 0 && jj == 0 && kk == 0)
+                                continue;
+                            if (use_datatype(halos, eta, true)) {
+                                auto send = make_datatype_outin<DataType>::inside(halos, eta);
+                                if (send.second)
+                                    m_send_region[neigh_idx(eta)] = send.first;
+                            }
+                            if (use_datatype(halos, eta, false)) {
+                                auto recv = make_datatype_outin<DataType>::outside(halos, eta);
+                                if (recv.second)
+                                    m_recv_region[neigh_idx(eta)] = recv.first;
+                            }
+                        }
+            }
+
+            bool any() const {
+                for (auto type : m_send_region)
+                    if (type != MPI_DATATYPE_NULL)
+                        return true;
+                for (auto type : m_recv_region)
+                    if (type != MPI_DATATYPE_NULL)
+                        return true;
+                return false;
+            }
+
+            bool sends(array<int, DIMS> const &eta) const { return m_send_region[neigh_idx(eta)] != MPI_DATATYPE_NULL; }
+            bool receives(array<int, DIMS> const &eta) const {
+                return m_recv_region[neigh_idx(eta)] != MPI_DATATYPE_NULL;
+            }
+
+            /**
+               Sets the fields to be exchanged, the types of all the fields are only created again if the fields differ
+               from the last call.
+            */
+            void set_fields(std::vector<void *> const &fields) {
+                if (fields == m_fields)
+                    return;
+                free_types(m_send);
+                free_types(m_recv);
+                m_fields = fields;
+                for (int i = 0; i < _impl::static_pow3<DIMS>::value; ++i) {
+                    if (m_send_region[i] != MPI_DATATYPE_NULL)
+                        m_send[i] = all_fields(m_send_region[i], fields);
+                    if (m_recv_region[i] != MPI_DATATYPE_NULL)
+                        m_recv[i] = all_fields(m_recv_region[i], fields);
+                }
+            }
+
+            MPI_Datatype send_type(array<int, DIMS> const &eta) const { return m_send[neigh_idx(eta)]; }
+            MPI_Datatype recv_type(array<int, DIMS> const &eta) const { return m_recv[neigh_idx(eta)]; }
+        };
+    } // namespace _impl
+} // namespace gridtools
@@ -0,0 +1,193 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <vector>
+
+#include "../../common/array.hpp"
+#include "../../common/halo_descriptor.hpp"
+#include "../../common/make_array.hpp"
+#include "../../common/numerics.hpp"
+#include "../low_level/Halo_Exchange_3D.hpp"
+#include "../low_level/proc_grids_3D.hpp"
+#include "../low_level/translate.hpp"
+#include "descriptors.hpp"
+
+namespace gridtools {
+
+    /**
+       A halo exchange that aggregates the fields registered one by one until it is flushed. Fields of different
+       components can be added independently, each with its own halo widths, and flush() sends all of them with a
+       single message per neighbor, which saves the latency of one exchange per component when many small fields are
+       updated together.
+
+       \code
+       halo_exchange_session<double, layout_map, proc_layout> session(he.pattern().proc_grid());
+       session.add(u, u_halos);
+       session.add(tracer, tracer_halos);
+       session.flush();
+       \endcode
+
+       The message sizes are not communicated, so all processes must add fields with the same halos in the same
+       order between two flushes. The construction duplicates the communicator of the process grid, so it is
+       collective and a session should be kept and flushed repeatedly rather than created for every exchange. The
+       fields must be in host memory.
+
+       \tparam DataType Type of the elements of the fields
+       \tparam LayoutMap Position of each dimension of the user data in the increasing stride order
+       \tparam ProcLayout Dimension of the processor grid that corresponds to each dimension of the data
+    */
+    template <typename DataType, typename LayoutMap, typename ProcLayout>
+    class halo_exchange_session {
+        static const int DIMS = 3;
+        typedef translate_t<DIMS, typename default_layout_map<DIMS>::type> translate;
+
+      public:
+        /**
+           Type of the computing grid associated to the pattern
+        */
+        typedef MPI_3D_process_grid_t<DIMS> grid_type;
+
+        /**
+           Type of the Level 3 pattern used
+        */
+        typedef Halo_Exchange_3D<grid_type> pattern_type;
+
+      private:
+        struct registered_field {
+            DataType *m_ptr;
+            empty_field_no_dt m_halo;
+
+            registered_field(DataType *ptr) : m_ptr(ptr), m_halo() {}
+        };
+
+        pattern_type m_haloexch;
+        std::vector<registered_field> m_fields;
+        array<std::vector<DataType>, _impl::static_pow3<DIMS>::value> m_send_buffers;
+        array<std::vector<DataType>, _impl::static_pow3<DIMS>::value> m_recv_buffers;
+
+        halo_exchange_session(halo_exchange_session const &) = delete;
+        halo_exchange_session &operator=(halo_exchange_session const &) = delete;
+
+      public:
+        /**
+           Constructor, must be called by all processes of the grid
+
+           \param[in] grid The processor grid, typically the one of the halo exchange pattern of the fields
+        */
+        explicit halo_exchange_session(grid_type const &grid) : m_haloexch(grid) {}
+
+        /**
+           Registers a field to be exchanged at the next flush()
+
+           \param[in] field Pointer to the first element of the field, including the halo
+           \param[in] halos Halos of the field, in the logical order of the dimensions chosen by the application (0
+           is i, 1 is j and 2 is k), not in the increasing stride order
+        */
+        void add(DataType *field, array<halo_descriptor, DIMS> const &halos) {
+            m_fields.push_back(registered_field(field));
+            empty_field_no_dt &halo = m_fields.back().m_halo;
+            halo.add_halo(LayoutMap::template at<0>(), halos[0]);
+            halo.add_halo(LayoutMap::template at<1>(), halos[1]);
+            halo.add_halo(LayoutMap::template at<2>(), halos[2]);
+        }
+
+        /**
+           Number of fields registered since the last flush()
+        */
+        size_t pending() const { return m_fields.size(); }
+
+        /**
+           Exchanges the halos of all registered fields, with one message per neighbor, and clears the registration.
+           Must be called by all processes of the grid.
+        */
+        void flush() {
+            for_each_neighbor([this](array<int, DIMS> const &eta, int ii_P, int jj_P, int kk_P) {
+                size_t send_size = 0, recv_size = 0;
+                for (registered_field const &field : m_fields) {
+                    send_size += field.m_halo.send_buffer_size(eta);
+                    recv_size += field.m_halo.recv_buffer_size(eta);
+                }
+                std::vector<DataType> &send_buffer = m_send_buffers[translate()(eta[0], eta[1], eta[2])];
+                std::vector<DataType> &recv_buffer = m_recv_buffers[translate()(eta[0], eta[1], eta[2])];
+                send_buffer.resize(send_size);
+                recv_buffer.resize(recv_size);
+                m_haloexch.register_send_to_buffer(
+                    send_buffer.data(), send_size * sizeof(DataType), ii_P, jj_P, kk_P);
+                m_haloexch.register_receive_from_buffer(
+                    recv_buffer.data(), recv_size * sizeof(DataType), ii_P, jj_P, kk_P);
+            });
+
+            m_haloexch.post_receives();
+            pack();
+            m_haloexch.do_sends();
+            m_haloexch.wait();
+            unpack();
+
+            m_fields.clear();
+        }
+
+        /**
+           Retrieve the pattern from which the computing grid and other information can be retrieved.
+        */
+        pattern_type const &pattern() const { return m_haloexch; }
+
+      private:
+        void pack() {
+#pragma omp parallel for schedule(dynamic, 1)
+            for (int n = 0; n < _impl::static_pow3<DIMS>::value; ++n) {
+                array<int, DIMS> eta = neighbor(n);
+                if (!exists(eta))
+                    continue;
+                DataType *it = m_send_buffers[translate()(eta[0], eta[1], eta[2])].data();
+                for (registered_field const &field : m_fields)
+                    field.m_halo.pack(eta, field.m_ptr, it);
+            }
+        }
+
+        void unpack() {
+#pragma omp parallel for schedule(dynamic, 1)
+            for (int n = 0; n < _impl::static_pow3<DIMS>::value; ++n) {
+                array<int, DIMS> eta = neighbor(n);
+                if (!exists(eta))
+                    continue;
+                DataType *it = m_recv_buffers[translate()(eta[0], eta[1], eta[2])].data();
+                for (registered_field const &field : m_fields)
+                    field.m_halo.unpack(eta, field.m_ptr, it);
+            }
+        }
+
+        /// the coordinates relative to the halo of the n-th of the 27 neighbors (including the process itself)
+        static array<int, DIMS> neighbor(int n) { return make_array(n / 9 - 1, n / 3 % 3 - 1, n % 3 - 1); }
+
+        bool exists(array<int, DIMS> const &eta) const {
+            return (eta[0] != 0 || eta[1] != 0 || eta[2] != 0) &&
+                   m_haloexch.proc_grid().proc(eta[ProcLayout::template at<0>()],
+                       eta[ProcLayout::template at<1>()],
+                       eta[ProcLayout::template at<2>()]) != -1;
+        }
+
+        /**
+           Calls f(eta, ii_P, jj_P, kk_P) for all existing neighbors, with the coordinates relative to the halo (eta)
+           and to the process grid.
+        */
+        template <class F>
+        void for_each_neighbor(F const &f) const {
+            for (int n = 0; n < _impl::static_pow3<DIMS>::value; ++n) {
+                array<int, DIMS> eta = neighbor(n);
+                if (exists(eta))
+                    f(eta,
+                        eta[ProcLayout::template at<0>()],
+                        eta[ProcLayout::template at<1>()],
+                        eta[ProcLayout::template at<2>()]);
+            }
+        }
+    };
+} // namespace gridtools
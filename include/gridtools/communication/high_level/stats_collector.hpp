@@ -33,7 +33,8 @@ namespace gridtools {
         ee_start_exchange,
         ee_wait,
         ee_post_receives,
-        ee_do_sends
+        ee_do_sends,
+        ee_wait_unpack // wait and unpack of an exchange unpacking on arrival
     };
 
     struct ExchangeEvent {
@@ -280,7 +281,7 @@ namespace gridtools {
                 for (const_exchange_iterator it = exchange_begin(); it != exchange_end(); it++) {
                     if (it->type == ee_pack)
                         stream << pattern_map[it->pattern] << "\tstart\t" << it->fields << "\tfields" << std::endl;
-                    else if (it->type == ee_unpack)
+                    else if (it->type == ee_unpack || it->type == ee_wait_unpack)
                         stream << pattern_map[it->pattern] << "\tstop\t" << it->fields << "\tfields" << std::endl;
                 }
                 stream << "exchanges_end" << std::endl;
@@ -292,7 +293,7 @@ namespace gridtools {
             typedef std::map<ExchangeEventType, double> PatternTimeTable;
             PatternTimeTable time_table;
             time_table[ee_pack] = time_table[ee_unpack] = time_table[ee_wait] = time_table[ee_exchange] =
-                time_table[ee_start_exchange] = 0.;
+                time_table[ee_start_exchange] = time_table[ee_wait_unpack] = 0.;
             // a map that stores a time table for each pattern
             std::map<int, PatternTimeTable> pattern_times;
             // initialize time table for each pattern to zero
@@ -328,8 +329,9 @@ namespace gridtools {
                  it++) {
                 // local_times[0,1,2,3] = pack, wait, start_exchange, exchange times
                 // local_times[4] = sum of all times
+                // the overlapped wait and unpack of an exchange unpacking on arrival is counted as wait
                 local_times[0] = it->second[ee_pack] + it->second[ee_unpack];
-                local_times[1] = it->second[ee_wait];
+                local_times[1] = it->second[ee_wait] + it->second[ee_wait_unpack];
                 local_times[2] = it->second[ee_start_exchange];
                 local_times[3] = it->second[ee_exchange];
                 local_times[4] = std::accumulate(local_times, local_times + 4, 0.);
@@ -427,6 +429,7 @@ namespace gridtools {
             exchange_labels[ee_exchange] = std::string("exchange");
             exchange_labels[ee_start_exchange] = std::string("start exchg");
             exchange_labels[ee_wait] = std::string("wait");
+            exchange_labels[ee_wait_unpack] = std::string("wait+unpack");
 
             std::map<PatternType, std::string> pattern_labels;
             pattern_labels[pt_dynamic] = std::string("dynamic");
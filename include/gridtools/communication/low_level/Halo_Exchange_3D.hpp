@@ -153,10 +153,14 @@ namespace gridtools {
         typedef translate_t<3, typename default_layout_map<3>::type> translate;
 
         class sr_buffers {
-            char *m_buffers[27]; // there is ona buffer more to allow for a simple indexing
-            int m_size[27];      // Sizes in bytes
+            char *m_buffers[27];         // there is ona buffer more to allow for a simple indexing
+            int m_size[27];              // Sizes in bytes, or number of elements of m_datatype
+            MPI_Datatype m_datatype[27]; // MPI_CHAR unless a derived datatype is registered
           public:
             explicit sr_buffers() {
+                for (int i = 0; i < 27; ++i)
+                    m_datatype[i] = MPI_CHAR;
+
                 m_buffers[0] = nullptr;
                 m_buffers[1] = nullptr;
                 m_buffers[2] = nullptr;
@@ -217,6 +221,7 @@ namespace gridtools {
             char *&buffer(int I, int J, int K) { return m_buffers[translate()(I, J, K)]; }
             int &size(int I, int J, int K) { return m_size[translate()(I, J, K)]; }
             int size(int I, int J, int K) const { return m_size[translate()(I, J, K)]; }
+            MPI_Datatype &datatype(int I, int J, int K) { return m_datatype[translate()(I, J, K)]; }
         };
 
         template <int I, int J, int K>
@@ -243,14 +248,166 @@ namespace gridtools {
             void reset(int i, int j, int k) { mark[translate()(i, j, k)] = false; }
         };
 
+        /* Persistent requests of the neighbors, together with the buffer, size and datatype they were initialized
+           with. They are freed with the pattern, copies of the pattern initialize their own requests. */
+        class persistent_request_set {
+            MPI_Request m_request[27];
+            char *m_buffer[27];
+            int m_size[27];
+            MPI_Datatype m_datatype[27];
+
+            void clear() {
+                for (int i = 0; i < 27; ++i) {
+                    m_request[i] = MPI_REQUEST_NULL;
+                    m_buffer[i] = nullptr;
+                    m_size[i] = 0;
+                    m_datatype[i] = MPI_CHAR;
+                }
+            }
+
+          public:
+            persistent_request_set() { clear(); }
+            persistent_request_set(persistent_request_set const &) { clear(); }
+            persistent_request_set &operator=(persistent_request_set const &) = delete;
+
+            ~persistent_request_set() {
+                int finalized;
+                MPI_Finalized(&finalized);
+                if (finalized)
+                    return;
+                for (int i = 0; i < 27; ++i)
+                    if (m_request[i] != MPI_REQUEST_NULL)
+                        MPI_Request_free(&m_request[i]);
+            }
+
+            /* Returns the request of neighbor (I, J, K), calling init(&request) to initialize it if it was not yet
+               initialized with the same buffer, size and datatype. */
+            template <class Init>
+            MPI_Request get(int I, int J, int K, char *buffer, int size, MPI_Datatype datatype, Init const &init) {
+                const int n = translate()(I, J, K);
+                if (m_request[n] == MPI_REQUEST_NULL || m_buffer[n] != buffer || m_size[n] != size ||
+                    m_datatype[n] != datatype) {
+                    if (m_request[n] != MPI_REQUEST_NULL)
+                        MPI_Request_free(&m_request[n]);
+                    init(&m_request[n]);
+                    m_buffer[n] = buffer;
+                    m_size[n] = size;
+                    m_datatype[n] = datatype;
+                }
+                return m_request[n];
+            }
+        };
+
         sr_buffers m_send_buffers;
         sr_buffers m_recv_buffers;
 
-        request_t request;
+        request_t_mark request;
         request_t_mark send_request;
 
+        persistent_request_set m_persistent_recvs;
+        persistent_request_set m_persistent_sends;
+#ifdef GT_HALO_PERSISTENT_REQUESTS
+        bool m_persistent = true;
+#else
+        bool m_persistent = false;
+#endif
+
         const PROC_GRID /*&*/ m_proc_grid;
 
+        /* Tag of the messages sent to neighbor (I, J, K), equal to TAG<I, J, K>::value */
+        static int tag(int I, int J, int K) { return (K + 1) * 9 + (I + 1) * 3 + J + 1; }
+
+        bool is_neighbor(int I, int J, int K) const {
+            return (I != 0 || J != 0 || K != 0) && m_proc_grid.proc(I, J, K) != -1;
+        }
+
+        MPI_Request persistent_receive(int I, int J, int K) {
+            char *buffer = m_recv_buffers.buffer(I, J, K);
+            const int size = m_recv_buffers.size(I, J, K);
+            const MPI_Datatype datatype = m_recv_buffers.datatype(I, J, K);
+            return m_persistent_recvs.get(I, J, K, buffer, size, datatype, [&](MPI_Request *r) {
+                MPI_Recv_init(buffer,
+                    size,
+                    datatype,
+                    m_proc_grid.proc(I, J, K),
+                    tag(-I, -J, -K),
+                    get_communicator(m_proc_grid),
+                    r);
+            });
+        }
+
+        MPI_Request persistent_send(int I, int J, int K) {
+            char *buffer = m_send_buffers.buffer(I, J, K);
+            const int size = m_send_buffers.size(I, J, K);
+            const MPI_Datatype datatype = m_send_buffers.datatype(I, J, K);
+            return m_persistent_sends.get(I, J, K, buffer, size, datatype, [&](MPI_Request *r) {
+                MPI_Send_init(
+                    buffer, size, datatype, m_proc_grid.proc(I, J, K), tag(I, J, K), get_communicator(m_proc_grid), r);
+            });
+        }
+
+        /* Starts the persistent receives from all neighbors with data to receive with a single MPI_Startall */
+        void start_persistent_receives() {
+            MPI_Request requests[27];
+            int n = 0;
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (is_neighbor(i, j, k) && m_recv_buffers.size(i, j, k)) {
+                            request(-i, -j, -k) = requests[n++] = persistent_receive(i, j, k);
+                            request.set(-i, -j, -k);
+                        }
+#ifdef GCL_TRACE
+            double begin_time = MPI_Wtime();
+#endif
+            MPI_Startall(n, requests);
+#ifdef GCL_TRACE
+            double end_time = MPI_Wtime();
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (request.marked(-i, -j, -k))
+                            stats_collector_3D.add_event(CommEvent(ce_receive,
+                                m_proc_grid.proc(i, j, k),
+                                tag(-i, -j, -k),
+                                m_recv_buffers.size(i, j, k),
+                                begin_time,
+                                end_time,
+                                pattern_tag));
+#endif
+        }
+
+        /* Starts the persistent sends to all neighbors with data to send with a single MPI_Startall */
+        void start_persistent_sends() {
+            MPI_Request requests[27];
+            int n = 0;
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (is_neighbor(i, j, k) && m_send_buffers.size(i, j, k)) {
+                            send_request(i, j, k) = requests[n++] = persistent_send(i, j, k);
+                            send_request.set(i, j, k);
+                        }
+#ifdef GCL_TRACE
+            double begin_time = MPI_Wtime();
+#endif
+            MPI_Startall(n, requests);
+#ifdef GCL_TRACE
+            double end_time = MPI_Wtime();
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (send_request.marked(i, j, k))
+                            stats_collector_3D.add_event(CommEvent(ce_send,
+                                m_proc_grid.proc(i, j, k),
+                                tag(i, j, k),
+                                m_send_buffers.size(i, j, k),
+                                begin_time,
+                                end_time,
+                                pattern_tag));
+#endif
+        }
+
         template <int I, int J, int K>
         void post_receive() {
             if (m_recv_buffers.size(I, J, K)) {
@@ -268,11 +425,12 @@ namespace gridtools {
 
                 MPI_Irecv(static_cast<char *>(m_recv_buffers.buffer(I, J, K)),
                     m_recv_buffers.size(I, J, K),
-                    MPI_CHAR,
+                    m_recv_buffers.datatype(I, J, K),
                     m_proc_grid.template proc<I, J, K>(),
                     TAG<-I, -J, -K>::value,
                     get_communicator(m_proc_grid),
                     &request(-I, -J, -K));
+                request.set(-I, -J, -K);
 #ifdef GCL_TRACE
                 double end_time = MPI_Wtime();
                 stats_collector_3D.add_event(CommEvent(ce_receive,
@@ -303,7 +461,7 @@ namespace gridtools {
 
                 MPI_Isend(static_cast<char *>(m_send_buffers.buffer(I, J, K)),
                     m_send_buffers.size(I, J, K),
-                    MPI_CHAR,
+                    m_send_buffers.datatype(I, J, K),
                     m_proc_grid.template proc<I, J, K>(),
                     TAG<I, J, K>::value,
                     get_communicator(m_proc_grid),
@@ -323,22 +481,27 @@ namespace gridtools {
             }
         }
 
+        /* Waits for all sends with a single MPI_Waitall */
         void wait_for_sends() {
-            MPI_Status status;
+            MPI_Request requests[27];
+            int n = 0;
             for (int i = -1; i <= 1; ++i)
                 for (int j = -1; j <= 1; ++j)
                     for (int k = -1; k <= 1; ++k)
-                        if (send_request.marked(i, j, k)) {
+                        if (send_request.marked(i, j, k))
+                            requests[n++] = send_request(i, j, k);
 #ifdef GCL_TRACE
-                            double begin_time = MPI_Wtime();
+            double begin_time = MPI_Wtime();
 #endif
-                            MPI_Wait(&send_request(i, j, k), &status);
+            MPI_Waitall(n, requests, MPI_STATUSES_IGNORE);
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (send_request.marked(i, j, k)) {
 #ifdef GCL_TRACE
                             double end_time = MPI_Wtime();
                             stats_collector_3D.add_event(CommEvent(ce_send_wait,
-                                // m_proc_grid.template proc<I,J,K>(),
                                 m_proc_grid.proc(i, j, k),
-                                // TAG<I,J,K>::value,
                                 -1,
                                 m_send_buffers.size(i, j, k),
                                 begin_time,
@@ -349,33 +512,6 @@ namespace gridtools {
                         }
         }
 
-        template <int I, int J, int K>
-        void wait() {
-            if (m_recv_buffers.size(I, J, K)) {
-#ifdef GT_VERBOSE
-                std::cout << "@" << gridtools::PID << "@ WAIT  (" << I << "," << J << "," << K << ") "
-                          << " R " << translate()(-I, -J, -K) << "\n";
-#endif
-
-#ifdef GCL_TRACE
-                double begin_time = MPI_Wtime();
-#endif
-
-                MPI_Status status;
-                MPI_Wait(&request(-I, -J, -K), &status);
-#ifdef GCL_TRACE
-                double end_time = MPI_Wtime();
-                stats_collector_3D.add_event(CommEvent(ce_receive_wait,
-                    m_proc_grid.template proc<I, J, K>(),
-                    TAG<-I, -J, -K>::value,
-                    m_recv_buffers.size(I, J, K),
-                    begin_time,
-                    end_time,
-                    pattern_tag));
-#endif
-            }
-        }
-
 #ifdef GCL_TRACE
         int pattern_tag;
 #endif
@@ -446,6 +582,7 @@ namespace gridtools {
 
             m_send_buffers.buffer(I, J, K) = reinterpret_cast<char *>(p);
             m_send_buffers.size(I, J, K) = s;
+            m_send_buffers.datatype(I, J, K) = MPI_CHAR;
         }
 
         /** Function to register send buffers with the communication patter.
@@ -509,6 +646,7 @@ namespace gridtools {
 
             m_recv_buffers.buffer(I, J, K) = reinterpret_cast<char *>(p);
             m_recv_buffers.size(I, J, K) = s;
+            m_recv_buffers.datatype(I, J, K) = MPI_CHAR;
         }
 
         /** Function to register buffers for received data with the communication patter.
@@ -539,6 +677,79 @@ namespace gridtools {
             register_receive_from_buffer(p, s, I, J, K);
         }
 
+        /** Function to register data to be sent with an MPI derived datatype instead of a buffer of bytes.
+
+           One element of the datatype is sent, starting at p (which can be MPI_BOTTOM if the datatype contains
+           absolute addresses). The registration holds until a buffer is registered again for the same destination.
+
+           \param[in] p Base address of the datatype
+           \param[in] type Committed MPI datatype describing the data to be sent
+           \param[in] I Relative coordinates of the receiving process along the first dimension
+           \param[in] J Relative coordinates of the receiving process along the second dimension
+           \param[in] K Relative coordinates of the receiving process along the third dimension
+        */
+        void register_send_to_datatype(void *p, MPI_Datatype type, int I, int J, int K) {
+            assert((I >= -1 && I <= 1));
+            assert((J >= -1 && J <= 1));
+            assert((K >= -1 && K <= 1));
+
+            m_send_buffers.buffer(I, J, K) = reinterpret_cast<char *>(p);
+            m_send_buffers.size(I, J, K) = 1;
+            m_send_buffers.datatype(I, J, K) = type;
+        }
+
+        /** Function to register data to be received with an MPI derived datatype instead of a buffer of bytes.
+
+           \param[in] p Base address of the datatype
+           \param[in] type Committed MPI datatype describing where to put the received data
+           \param[in] I Relative coordinates of the sending process along the first dimension
+           \param[in] J Relative coordinates of the sending process along the second dimension
+           \param[in] K Relative coordinates of the sending process along the third dimension
+        */
+        void register_receive_from_datatype(void *p, MPI_Datatype type, int I, int J, int K) {
+            assert((I >= -1 && I <= 1));
+            assert((J >= -1 && J <= 1));
+            assert((K >= -1 && K <= 1));
+
+            m_recv_buffers.buffer(I, J, K) = reinterpret_cast<char *>(p);
+            m_recv_buffers.size(I, J, K) = 1;
+            m_recv_buffers.datatype(I, J, K) = type;
+        }
+
+        /** Function to post the receive from a single neighbor. This is needed when the data to be received from it
+           is registered after post_receives() has been called (with size 0 at that time).
+
+           \param[in] I Relative coordinates of the sending process along the first dimension
+           \param[in] J Relative coordinates of the sending process along the second dimension
+           \param[in] K Relative coordinates of the sending process along the third dimension
+        */
+        void post_receive_from(int I, int J, int K) {
+            const int proc = m_proc_grid.proc(I, J, K);
+            if (proc == -1 || !m_recv_buffers.size(I, J, K))
+                return;
+#ifdef GCL_TRACE
+            double begin_time = MPI_Wtime();
+#endif
+            if (m_persistent) {
+                request(-I, -J, -K) = persistent_receive(I, J, K);
+                MPI_Start(&request(-I, -J, -K));
+            } else {
+                MPI_Irecv(static_cast<char *>(m_recv_buffers.buffer(I, J, K)),
+                    m_recv_buffers.size(I, J, K),
+                    m_recv_buffers.datatype(I, J, K),
+                    proc,
+                    tag(-I, -J, -K),
+                    get_communicator(m_proc_grid),
+                    &request(-I, -J, -K));
+            }
+            request.set(-I, -J, -K);
+#ifdef GCL_TRACE
+            double end_time = MPI_Wtime();
+            stats_collector_3D.add_event(CommEvent(
+                ce_receive, proc, tag(-I, -J, -K), m_recv_buffers.size(I, J, K), begin_time, end_time, pattern_tag));
+#endif
+        }
+
         /* Setting sizes */
 
         /** Function to set send buffers sizes if the size must be updated
@@ -668,6 +879,11 @@ namespace gridtools {
         }
 
         void post_receives() {
+            if (m_persistent) {
+                start_persistent_receives();
+                return;
+            }
+
             /* Posting receives face -1
              */
             if (m_proc_grid.template proc<1, 0, -1>() != -1) {
@@ -786,6 +1002,11 @@ namespace gridtools {
         }
 
         void do_sends() {
+            if (m_persistent) {
+                start_persistent_sends();
+                return;
+            }
+
             /* Sending data face -1
              */
             if (m_proc_grid.template proc<-1, 0, -1>() != -1) {
@@ -933,122 +1154,76 @@ namespace gridtools {
             do_sends();
         }
 
+        /** When called this function waits for all messages of the exchange to be sent and received. The receives
+            are completed with MPI_Waitany and the sends with MPI_Waitall.
+         */
         void wait() {
+            wait_each([](int, int, int) {});
+        }
 
-            wait_for_sends();
-
-            /* Actual receives face -1
-             */
-            if (m_proc_grid.template proc<1, 0, -1>() != -1) {
-                wait<1, 0, -1>();
-            }
-
-            if (m_proc_grid.template proc<-1, 0, -1>() != -1) {
-                wait<-1, 0, -1>();
-            }
-
-            if (m_proc_grid.template proc<0, 1, -1>() != -1) {
-                wait<0, 1, -1>();
-            }
-
-            if (m_proc_grid.template proc<0, -1, -1>() != -1) {
-                wait<0, -1, -1>();
-            }
-
-            if (m_proc_grid.template proc<1, 1, -1>() != -1) {
-                wait<1, 1, -1>();
-            }
-
-            if (m_proc_grid.template proc<-1, -1, -1>() != -1) {
-                wait<-1, -1, -1>();
-            }
-
-            if (m_proc_grid.template proc<-1, 1, -1>() != -1) {
-                wait<-1, 1, -1>();
-            }
-
-            if (m_proc_grid.template proc<1, -1, -1>() != -1) {
-                wait<1, -1, -1>();
-            }
-
-            if (m_proc_grid.template proc<0, 0, -1>() != -1) {
-                wait<0, 0, -1>();
-            }
-
-            /* Actual receives face 0
-             */
-            if (m_proc_grid.template proc<1, 0, 0>() != -1) {
-                wait<1, 0, 0>();
-            }
-
-            if (m_proc_grid.template proc<-1, 0, 0>() != -1) {
-                wait<-1, 0, 0>();
-            }
-
-            if (m_proc_grid.template proc<0, 1, 0>() != -1) {
-                wait<0, 1, 0>();
-            }
-
-            if (m_proc_grid.template proc<0, -1, 0>() != -1) {
-                wait<0, -1, 0>();
-            }
-
-            if (m_proc_grid.template proc<1, 1, 0>() != -1) {
-                wait<1, 1, 0>();
-            }
-
-            if (m_proc_grid.template proc<-1, -1, 0>() != -1) {
-                wait<-1, -1, 0>();
-            }
-
-            if (m_proc_grid.template proc<-1, 1, 0>() != -1) {
-                wait<-1, 1, 0>();
-            }
-
-            if (m_proc_grid.template proc<1, -1, 0>() != -1) {
-                wait<1, -1, 0>();
-            }
-
-            /* Actual receives face -1
-             */
-            if (m_proc_grid.template proc<1, 0, 1>() != -1) {
-                wait<1, 0, 1>();
-            }
-
-            if (m_proc_grid.template proc<-1, 0, 1>() != -1) {
-                wait<-1, 0, 1>();
-            }
-
-            if (m_proc_grid.template proc<0, 1, 1>() != -1) {
-                wait<0, 1, 1>();
-            }
-
-            if (m_proc_grid.template proc<0, -1, 1>() != -1) {
-                wait<0, -1, 1>();
-            }
+        /** As wait(), but calls f(I, J, K) as soon as the data from neighbor (I, J, K) (coordinates relative to the
+            calling process) has arrived, in order of arrival, while the other messages may still be in flight. This
+            allows to unpack each message on arrival. The sends are completed after all receives.
 
-            if (m_proc_grid.template proc<1, 1, 1>() != -1) {
-                wait<1, 1, 1>();
-            }
+            \param[in] f Function called with the coordinates of each neighbor whose data has been received
+         */
+        template <class F>
+        void wait_each(F const &f) {
+            MPI_Request requests[27];
+            int neighbors[27][3];
+            int n = 0;
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (request.marked(-i, -j, -k)) {
+                            requests[n] = request(-i, -j, -k);
+                            neighbors[n][0] = i;
+                            neighbors[n][1] = j;
+                            neighbors[n][2] = k;
+                            request.reset(-i, -j, -k);
+                            ++n;
+                        }
 
-            if (m_proc_grid.template proc<-1, -1, 1>() != -1) {
-                wait<-1, -1, 1>();
+            for (int c = 0; c < n; ++c) {
+#ifdef GCL_TRACE
+                double begin_time = MPI_Wtime();
+#endif
+                int index;
+                MPI_Waitany(n, requests, &index, MPI_STATUS_IGNORE);
+                const int i = neighbors[index][0];
+                const int j = neighbors[index][1];
+                const int k = neighbors[index][2];
+#ifdef GT_VERBOSE
+                std::cout << "@" << gridtools::PID << "@ WAIT  (" << i << "," << j << "," << k << ") "
+                          << " R " << translate()(-i, -j, -k) << "\n";
+#endif
+#ifdef GCL_TRACE
+                double end_time = MPI_Wtime();
+                stats_collector_3D.add_event(CommEvent(ce_receive_wait,
+                    m_proc_grid.proc(i, j, k),
+                    tag(-i, -j, -k),
+                    m_recv_buffers.size(i, j, k),
+                    begin_time,
+                    end_time,
+                    pattern_tag));
+#endif
+                f(i, j, k);
             }
 
-            if (m_proc_grid.template proc<-1, 1, 1>() != -1) {
-                wait<-1, 1, 1>();
-            }
+            wait_for_sends();
+        }
 
-            if (m_proc_grid.template proc<1, -1, 1>() != -1) {
-                wait<1, -1, 1>();
-            }
+        /** Function to select whether the messages are sent and received with persistent MPI requests
+            (MPI_Send_init/MPI_Recv_init, started with MPI_Startall on every exchange) instead of MPI_Isend/MPI_Irecv.
+            The requests are initialized at the first exchange and again only when the buffer, size or datatype of a
+            neighbor changes. The default is false, or true if GT_HALO_PERSISTENT_REQUESTS is defined. Must not be
+            changed during an exchange.
 
-            if (m_proc_grid.template proc<0, 0, 1>() != -1) {
-                wait<0, 0, 1>();
-            }
+            \param[in] persistent Whether to use persistent requests
+        */
+        void set_persistent_requests(bool persistent) { m_persistent = persistent; }
 
-            // MPI_Barrier(gridtools::GCL_WORLD);
-        }
+        bool persistent_requests() const { return m_persistent; }
     };
 
 } // namespace gridtools
@@ -10,6 +10,11 @@
 
 #pragma once
 
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
 /** \defgroup Distributed-Boundaries Distributed Boundary Conditions
  */
 
@@ -25,6 +30,7 @@
 #include "./mock_pattern.hpp"
 #endif
 #include "./grid_predicate.hpp"
+#include "./split_grid.hpp"
 
 #include "./bound_bc.hpp"
 
@@ -120,6 +126,9 @@ namespace gridtools {
         performance_meter_t m_meter_exchange;
         performance_meter_t m_meter_bc;
 
+        // completion of the exchange started by start_exchange, empty if no exchange is in progress
+        std::function<void()> m_pending;
+
       public:
         /**
             @brief Constructor of distributed_boundaries.
@@ -185,6 +194,25 @@ namespace gridtools {
         */
         template <typename... Jobs>
         void exchange(Jobs const &... jobs) {
+            start_exchange(jobs...);
+            finish_exchange();
+        }
+
+        /**
+            @brief Member function to start the communication on a list of jobs, see
+            distributed_boundaries::exchange. The halos are packed and the messages are sent, but the function returns
+            without waiting for them to arrive, so that computations that do not depend on the halos (see
+            gridtools::split_grid) can overlap with the communication.
+
+            The data stores must not be modified until distributed_boundaries::finish_exchange is called, which
+            completes the communication and applies the boundary conditions.
+
+            \param jobs Variadic list of jobs
+        */
+        template <typename... Jobs>
+        void start_exchange(Jobs const &... jobs) {
+            if (m_pending)
+                throw std::runtime_error("start_exchange called while an exchange is already in progress");
 #ifdef __CUDACC__
             // Workaround for cuda to handle tuple_cat. Compilation is a little slower.
             // This can be removed when nvcc supports it.
@@ -192,6 +220,8 @@ namespace gridtools {
 #else
             auto all_stores_for_exc = std::tuple_cat(collect_stores(jobs)...);
 #endif
+            using stores_seq_t =
+                meta::make_integer_sequence<uint_t, std::tuple_size<decltype(all_stores_for_exc)>::value>;
             if (m_max_stores < std::tuple_size<decltype(all_stores_for_exc)>::value) {
                 std::string err{"Too many data stores to be exchanged" +
                                 std::to_string(std::tuple_size<decltype(all_stores_for_exc)>::value) +
@@ -200,20 +230,48 @@ namespace gridtools {
             }
 
             m_meter_pack.start();
-            call_pack(all_stores_for_exc,
-                meta::make_integer_sequence<uint_t, std::tuple_size<decltype(all_stores_for_exc)>::value>{});
+            call_pack(all_stores_for_exc, stores_seq_t{});
             m_meter_pack.pause();
             m_meter_exchange.start();
-            m_he.exchange();
+            m_he.start_exchange();
             m_meter_exchange.pause();
-            m_meter_pack.start();
-            call_unpack(all_stores_for_exc,
-                meta::make_integer_sequence<uint_t, std::tuple_size<decltype(all_stores_for_exc)>::value>{});
-            m_meter_pack.pause();
 
-            boundary_only(jobs...);
+            auto all_jobs = std::make_tuple(jobs...);
+            m_pending = [this, all_stores_for_exc, all_jobs]() {
+                m_meter_exchange.start();
+                m_he.wait();
+                m_meter_exchange.pause();
+                m_meter_pack.start();
+                call_unpack(all_stores_for_exc, stores_seq_t{});
+                m_meter_pack.pause();
+
+                call_boundary_only(all_jobs, meta::make_integer_sequence<uint_t, sizeof...(Jobs)>{});
+            };
         }
 
+        /**
+            @brief Member function to complete the communication started by distributed_boundaries::start_exchange:
+            waits for the halos, unpacks them and applies the boundary conditions.
+        */
+        void finish_exchange() {
+            if (!m_pending)
+                throw std::runtime_error("finish_exchange called without a preceding start_exchange");
+            auto pending = std::move(m_pending);
+            m_pending = nullptr;
+            pending();
+        }
+
+#ifndef GT_ICOSAHEDRAL_GRIDS
+        /**
+            @brief Splits a grid into the interior, which does not depend on the halos exchanged by this object, and
+            the rim along the boundaries of the grid, which does. See gridtools::split_grid.
+        */
+        template <typename Axis>
+        split_grid_t<grid<Axis>> split(grid<Axis> const &grid) const {
+            return split_grid(grid, m_halos);
+        }
+#endif
+
         typename pattern_type::grid_type const &proc_grid() const { return m_he.comm(); }
 
         std::string print_meters() const {
@@ -235,6 +293,11 @@ namespace gridtools {
         }
 
       private:
+        template <typename JobsTuple, uint_t... Ids>
+        void call_boundary_only(JobsTuple const &jobs, meta::integer_sequence<uint_t, Ids...>) {
+            boundary_only(std::get<Ids>(jobs)...);
+        }
+
         template <typename BoundaryApply, typename ArgsTuple, uint_t... Ids>
         static void call_apply(
             BoundaryApply boundary_apply, ArgsTuple const &args, meta::integer_sequence<uint_t, Ids...>) {
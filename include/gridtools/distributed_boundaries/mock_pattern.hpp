@@ -92,6 +92,10 @@ namespace gridtools {
 
             void exchange() {}
 
+            void start_exchange() {}
+
+            void wait() {}
+
             template <typename... As>
             void pack(As...) {}
 
@@ -0,0 +1,100 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "../common/array.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "../stencil_composition/grid.hpp"
+
+#ifndef GT_ICOSAHEDRAL_GRIDS
+namespace gridtools {
+
+    /** \ingroup Distributed-Boundaries
+     * @{ */
+
+    /**
+        @brief Result of gridtools::split_grid: the interior of a grid, which does not depend on the halos, and the
+        rim, a list of up to four disjoint strips along the boundaries of the grid. Together they cover the grid
+        exactly once.
+    */
+    template <typename Grid>
+    struct split_grid_t {
+        /** The interior grid, or no grid if the whole grid is rim. */
+        std::vector<Grid> interior;
+        std::vector<Grid> rim;
+    };
+
+    namespace _impl {
+        inline halo_descriptor with_bounds(halo_descriptor const &hd, uint_t begin, uint_t end) {
+            return {hd.minus(), hd.plus(), begin, end, hd.total_length()};
+        }
+    } // namespace _impl
+
+    /**
+        @brief Splits a grid into the points that only read inner points of the storages and the rim of points that
+        read halo points, given the halo widths of the communication.
+
+        This allows to overlap the halo exchange with computation:
+        \verbatim
+            auto split = split_grid(grid, halos);
+            // one computation per grid, built with the same stencils
+            cabc.start_exchange(a, b);
+            for (auto &&g : split.interior)
+                make_computation<backend_t>(g, ...).run();
+            cabc.finish_exchange();
+            for (auto &&g : split.rim)
+                make_computation<backend_t>(g, ...).run();
+        \endverbatim
+
+        \param grid The grid to split
+        \param halos Halo descriptors of the exchange, only the minus and plus widths in i and j are used: they are the
+        maximal extents of the stencils reading the exchanged fields
+    */
+    template <typename Axis>
+    split_grid_t<grid<Axis>> split_grid(grid<Axis> const &grid, array<halo_descriptor, 3> const &halos) {
+        using grid_t = ::gridtools::grid<Axis>;
+        split_grid_t<grid_t> result;
+
+        auto const &di = grid.direction_i();
+        auto const &dj = grid.direction_j();
+        const uint_t i_minus = halos[0].minus(), i_plus = halos[0].plus();
+        const uint_t j_minus = halos[1].minus(), j_plus = halos[1].plus();
+
+        if (di.end() - di.begin() + 1 <= i_minus + i_plus || dj.end() - dj.begin() + 1 <= j_minus + j_plus) {
+            // no interior
+            result.rim.push_back(grid);
+            return result;
+        }
+
+        const uint_t i_first = di.begin() + i_minus, i_last = di.end() - i_plus;
+        const uint_t j_first = dj.begin() + j_minus, j_last = dj.end() - j_plus;
+        auto make = [&](uint_t ib, uint_t ie, uint_t jb, uint_t je) {
+            return grid_t(_impl::with_bounds(di, ib, ie), _impl::with_bounds(dj, jb, je), grid.value_list);
+        };
+
+        result.interior.push_back(make(i_first, i_last, j_first, j_last));
+        // strips along j span the full i range, strips along i only the interior j range
+        if (j_minus)
+            result.rim.push_back(make(di.begin(), di.end(), dj.begin(), j_first - 1));
+        if (j_plus)
+            result.rim.push_back(make(di.begin(), di.end(), j_last + 1, dj.end()));
+        if (i_minus)
+            result.rim.push_back(make(di.begin(), i_first - 1, j_first, j_last));
+        if (i_plus)
+            result.rim.push_back(make(i_last + 1, di.end(), j_first, j_last));
+        return result;
+    }
+
+    /** @} */
+} // namespace gridtools
+#endif
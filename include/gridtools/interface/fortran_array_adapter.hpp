@@ -11,6 +11,7 @@
 
 #include "../c_bindings/fortran_array_view.hpp"
 #include "../storage/common/storage_info_rt.hpp"
+#include "../storage/storage_facility.hpp"
 #include "./layout_transformation/layout_transformation.hpp"
 
 namespace gridtools {
@@ -10,57 +10,167 @@
 
 #pragma once
 
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 #include "../../common/defs.hpp"
-#include "../../common/hypercube_iterator.hpp"
-#include "../../common/layout_map_metafunctions.hpp"
-#include "../../common/make_array.hpp"
-#include "../../common/tuple_util.hpp"
-#include "../../storage/storage_facility.hpp"
 #include "layout_transformation_config.hpp"
-#include "layout_transformation_helper.hpp"
 
 namespace gridtools {
     namespace impl {
+        namespace _impl_transform_omp {
+            /**
+             * @brief Edge length (in elements) of the 2D tiles of the transposing kernel: a tile row fills two cache
+             * lines, so both source and destination are read/written in full lines.
+             */
+            template <typename DataType>
+            constexpr int_t tile_size() {
+                return 128 / sizeof(DataType) < 8 ? 8 : 128 / sizeof(DataType);
+            }
+
+            struct dimension {
+                int_t size;
+                int_t dst_stride;
+                int_t src_stride;
+            };
+
+            /**
+             * @brief Dimensions with extent larger than one, the dimension with the smallest destination stride first.
+             */
+            inline std::vector<dimension> sorted_dimensions(const std::vector<uint_t> &dims,
+                const std::vector<uint_t> &dst_strides,
+                const std::vector<uint_t> &src_strides) {
+                std::vector<dimension> result;
+                for (std::size_t d = 0; d < dims.size(); ++d) {
+                    if (dims[d] > 1)
+                        result.push_back({(int_t)dims[d], (int_t)dst_strides[d], (int_t)src_strides[d]});
+                }
+                std::stable_sort(result.begin(), result.end(), [](dimension const &a, dimension const &b) {
+                    return a.dst_stride < b.dst_stride;
+                });
+                return result;
+            }
+
+            /**
+             * @brief Offsets of the n-th point of the (flattened) outer dimensions, which start at `first`.
+             */
+            inline void outer_offsets(std::vector<dimension> const &dims,
+                std::size_t first,
+                int_t n,
+                int_t &dst_offset,
+                int_t &src_offset) {
+                dst_offset = 0;
+                src_offset = 0;
+                for (std::size_t d = first; d < dims.size(); ++d) {
+                    int_t index = n % dims[d].size;
+                    n /= dims[d].size;
+                    dst_offset += index * dims[d].dst_stride;
+                    src_offset += index * dims[d].src_stride;
+                }
+            }
+
+            /**
+             * @brief Copies along the dimension with the smallest destination stride, which the source shares as its
+             * fastest dimension (or which is the only one).
+             */
+            template <typename DataType>
+            void copy_lines(DataType *dst, DataType const *src, std::vector<dimension> const &dims) {
+                const int_t size = dims[0].size;
+                const int_t dst_stride = dims[0].dst_stride;
+                const int_t src_stride = dims[0].src_stride;
+                int_t lines = 1;
+                for (std::size_t d = 1; d < dims.size(); ++d)
+                    lines *= dims[d].size;
+#pragma omp parallel for
+                for (int_t line = 0; line < lines; ++line) {
+                    int_t dst_offset, src_offset;
+                    outer_offsets(dims, 1, line, dst_offset, src_offset);
+                    DataType *GT_RESTRICT d = dst + dst_offset;
+                    DataType const *GT_RESTRICT s = src + src_offset;
+#pragma omp simd
+                    for (int_t i = 0; i < size; ++i)
+                        d[i * dst_stride] = s[i * src_stride];
+                }
+            }
+
+            /**
+             * @brief Tiled 2D transpose of dimension 0 (smallest destination stride) and dimension `src_dim` (smallest
+             * source stride); the loops over all other dimensions and over the tiles are flattened into a single
+             * parallel loop.
+             */
+            template <typename DataType>
+            void copy_tiles(DataType *dst, DataType const *src, std::vector<dimension> dims, std::size_t src_dim) {
+                constexpr int_t tile = tile_size<DataType>();
+                std::swap(dims[1], dims[src_dim]);
+                const dimension d0 = dims[0];
+                const dimension d1 = dims[1];
+                const int_t tiles0 = (d0.size + tile - 1) / tile;
+                const int_t tiles1 = (d1.size + tile - 1) / tile;
+                int_t outer = 1;
+                for (std::size_t d = 2; d < dims.size(); ++d)
+                    outer *= dims[d].size;
+
+#pragma omp parallel for
+                for (int_t n = 0; n < outer * tiles1 * tiles0; ++n) {
+                    const int_t t0 = n % tiles0;
+                    const int_t t1 = n / tiles0 % tiles1;
+                    int_t dst_offset, src_offset;
+                    outer_offsets(dims, 2, n / tiles0 / tiles1, dst_offset, src_offset);
+
+                    const int_t i0_first = t0 * tile;
+                    const int_t i0_last = std::min(i0_first + tile, d0.size);
+                    const int_t i1_first = t1 * tile;
+                    const int_t i1_last = std::min(i1_first + tile, d1.size);
+                    // rows of the tile are contiguous in the destination, the source lines of the tile are reused
+                    // from L1 across the rows
+                    for (int_t i1 = i1_first; i1 < i1_last; ++i1) {
+                        DataType *GT_RESTRICT d = dst + dst_offset + i1 * d1.dst_stride;
+                        DataType const *GT_RESTRICT s = src + src_offset + i1 * d1.src_stride;
+#pragma omp simd
+                        for (int_t i0 = i0_first; i0 < i0_last; ++i0)
+                            d[i0 * d0.dst_stride] = s[i0 * d0.src_stride];
+                    }
+                }
+            }
+        } // namespace _impl_transform_omp
+
+        /**
+         * @brief Copies between two arbitrarily strided layouts of the same index space.
+         *
+         * The loop nest is chosen from the strides: if source and destination share their fastest dimension, the
+         * data is copied line by line; otherwise the two fastest dimensions are transposed in cache-sized tiles.
+         */
         template <typename DataType>
         void transform_openmp_loop(DataType *dst,
             DataType *src,
             const std::vector<uint_t> &dims,
             const std::vector<uint_t> &dst_strides,
             const std::vector<uint_t> &src_strides) {
+            using namespace _impl_transform_omp;
 
             if (dims.size() > GT_TRANSFORM_MAX_DIM)
                 throw std::runtime_error("Reached compile time GT_TRANSFORM_MAX_DIM in layout transformation. Increase "
                                          "the value for higher dimensional transformations.");
+            if (std::find(dims.begin(), dims.end(), 0) != dims.end())
+                return;
+
+            auto sorted_dims = sorted_dimensions(dims, dst_strides, src_strides);
+            if (sorted_dims.empty()) {
+                *dst = *src;
+                return;
+            }
 
-            using dummy_layout_map =
-                default_layout_map_t<GT_TRANSFORM_MAX_DIM>; // not used since we pass strides directly
-
-            using storage_info = gridtools::storage_info<0, dummy_layout_map>;
-            auto a_dims = impl::vector_to_dims_array<GT_TRANSFORM_MAX_DIM>(dims);
-            auto a_dst_strides = impl::vector_to_strides_array<GT_TRANSFORM_MAX_DIM>(dst_strides);
-            auto a_src_strides = impl::vector_to_strides_array<GT_TRANSFORM_MAX_DIM>(src_strides);
-
-            storage_info si_dst(a_dims, a_dst_strides);
-            storage_info si_src(a_dims, a_src_strides);
-
-            array<size_t, GT_TRANSFORM_MAX_DIM - 3> outer_dims;
-            for (size_t i = 0; i < GT_TRANSFORM_MAX_DIM - 3; ++i)
-                outer_dims[i] = a_dims[3 + i];
-
-            for (auto &&outer : make_hypercube_view(outer_dims)) {
-                uint_t size_i = a_dims[0]; // because ICC 17 complains otherwise...
-                uint_t size_j = a_dims[1];
-                uint_t size_k = a_dims[2];
-#pragma omp parallel for collapse(3)
-                for (int i = 0; i < (int)size_i; ++i)
-                    for (int j = 0; j < (int)size_j; ++j)
-                        for (int k = 0; k < (int)size_k; ++k) {
-                            auto index = tuple_util::push_front(tuple_util::convert_to<array, int>(outer), i, j, k);
-                            dst[si_dst.index(index)] = src[si_src.index(index)];
-                        }
+            std::size_t src_dim = 0;
+            for (std::size_t d = 1; d < sorted_dims.size(); ++d) {
+                if (sorted_dims[d].src_stride < sorted_dims[src_dim].src_stride)
+                    src_dim = d;
             }
+
+            if (src_dim == 0)
+                copy_lines(dst, src, sorted_dims);
+            else
+                copy_tiles(dst, src, sorted_dims, src_dim);
         }
     } // namespace impl
 } // namespace gridtools
@@ -35,4 +35,15 @@ namespace gridtools {
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
     constexpr std::true_type mss_fuse_esfs(backend::cuda) { return {}; }
+
+    /**
+     * @brief determines whether the backend loops can share their work with the threads of an enclosing parallel region
+     * (see `_impl::enclosing_omp_team`).
+     */
+    constexpr std::false_type shares_enclosing_omp_team(backend::cuda) { return {}; }
+
+    /**
+     * @brief determines whether the backend calls a block epilogue after every block.
+     */
+    constexpr std::false_type runs_block_epilogues(backend::cuda) { return {}; }
 } // namespace gridtools
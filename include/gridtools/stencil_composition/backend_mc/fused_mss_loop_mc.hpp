@@ -9,7 +9,11 @@
  */
 #pragma once
 
+#include <omp.h>
+
 #include "../mss_functor.hpp"
+#include "../structured_grids/backend_mc/block_tuner_mc.hpp"
+#include "./work_stealing_mc.hpp"
 
 /**@file
  * @brief fused mss loop implementations for the mc backend
@@ -27,58 +31,215 @@ namespace gridtools {
          */
         template <typename Msses>
         GT_META_DEFINE_ALIAS(all_mss_kparallel, meta::all_of, (is_mss_kparallel, Msses));
+
+        /**
+         * @brief Calls `f` with the block decomposition to use for this run.
+         *
+         * If GT_MC_AUTOTUNE is defined, the decomposition is selected by the block tuner of the stencil and the time
+         * spent in `f` is reported back to it until tuning has finished.
+         */
+        template <class Stencil, class Grid, class F>
+        void with_execinfo_mc(Grid const &grid, F const &f) {
+#ifdef GT_MC_AUTOTUNE
+            block_tuner_mc &tuner = get_block_tuner_mc<Stencil>(grid);
+            if (tuner.tuned()) {
+                f(tuner.execinfo(grid));
+                return;
+            }
+            const double start = omp_get_wtime();
+            f(tuner.execinfo(grid));
+            tuner.report(omp_get_wtime() - start);
+#else
+            f(execinfo_mc(grid));
+#endif
+        }
+
+        /**
+         * @brief Runs all mss functors on a block of a k-serial stencil, followed by the block epilogue.
+         */
+        template <class MssComponents, class LocalDomainListArray, class Grid, class BlockEpilogue>
+        void run_block_mc(LocalDomainListArray const &local_domain_lists,
+            Grid const &grid,
+            execinfo_block_kserial_mc const &block,
+            BlockEpilogue const &epilogue) {
+            run_mss_functors<MssComponents>(backend::mc{}, local_domain_lists, grid, block);
+            epilogue(block.i_first,
+                block.i_first + block.i_block_size - 1,
+                block.j_first,
+                block.j_first + block.j_block_size - 1,
+                grid.k_min(),
+                grid.k_max());
+        }
+
+        /**
+         * @brief Runs all mss functors on a block of a k-parallel stencil, followed by the block epilogue.
+         */
+        template <class MssComponents, class LocalDomainListArray, class Grid, class BlockEpilogue>
+        void run_block_mc(LocalDomainListArray const &local_domain_lists,
+            Grid const &grid,
+            execinfo_block_kparallel_mc const &block,
+            BlockEpilogue const &epilogue) {
+            run_mss_functors<MssComponents>(backend::mc{}, local_domain_lists, grid, block);
+            epilogue(block.i_first,
+                block.i_first + block.i_block_size - 1,
+                block.j_first,
+                block.j_first + block.j_block_size - 1,
+                block.k,
+                block.k);
+        }
+
+        /**
+         * @brief Shares the blocks of a k-serial stencil among the threads of the current team, without a barrier.
+         *
+         * The schedule is static, so that each thread gets the same blocks on every call with the same grid.
+         */
+        template <class MssComponents, class LocalDomainListArray, class Grid, class BlockEpilogue>
+        void blocks_loop_mc(LocalDomainListArray const &local_domain_lists,
+            Grid const &grid,
+            execinfo_mc const &exinfo,
+            BlockEpilogue const &epilogue,
+            std::false_type /*k_parallel*/) {
+            const int_t i_blocks = exinfo.i_blocks();
+            const int_t j_blocks = exinfo.j_blocks();
+#pragma omp for collapse(2) schedule(static) nowait
+            for (int_t bj = 0; bj < j_blocks; ++bj) {
+                for (int_t bi = 0; bi < i_blocks; ++bi) {
+                    run_block_mc<MssComponents>(local_domain_lists, grid, exinfo.block(bi, bj), epilogue);
+                }
+            }
+        }
+
+        /**
+         * @brief Shares the blocks of a k-parallel stencil among the threads of the current team, without a barrier.
+         */
+        template <class MssComponents, class LocalDomainListArray, class Grid, class BlockEpilogue>
+        void blocks_loop_mc(LocalDomainListArray const &local_domain_lists,
+            Grid const &grid,
+            execinfo_mc const &exinfo,
+            BlockEpilogue const &epilogue,
+            std::true_type /*k_parallel*/) {
+            const int_t i_blocks = exinfo.i_blocks();
+            const int_t j_blocks = exinfo.j_blocks();
+            const int_t k_first = grid.k_min();
+            const int_t k_last = grid.k_max();
+#pragma omp for collapse(3) schedule(static) nowait
+            for (int_t bj = 0; bj < j_blocks; ++bj) {
+                for (int_t k = k_first; k <= k_last; ++k) {
+                    for (int_t bi = 0; bi < i_blocks; ++bi) {
+                        run_block_mc<MssComponents>(local_domain_lists, grid, exinfo.block(bi, bj, k), epilogue);
+                    }
+                }
+            }
+        }
     } // namespace _impl
 
     /**
      * @brief loops over all blocks and execute sequentially all mss functors for each block
+     *
+     * If GT_MC_WORK_STEALING is defined, blocks are distributed by the work-stealing scheduler, otherwise statically.
+     * If GT_MC_AUTOTUNE is defined, the block sizes are tuned during the first runs.
+     * The block epilogue is called after every block (see `_impl::no_block_epilogue`).
      * @tparam MssComponents a meta array with the mss components of all MSS
      */
     template <class MssComponents,
         class LocalDomainListArray,
         class Grid,
+        class BlockEpilogue = _impl::no_block_epilogue,
         enable_if_t<!_impl::all_mss_kparallel<MssComponents>::value, int> = 0>
-    void fused_mss_loop(backend::mc, LocalDomainListArray const &local_domain_lists, const Grid &grid) {
+    void fused_mss_loop(backend::mc,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        BlockEpilogue const &epilogue = {}) {
         GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
-
-        execinfo_mc exinfo(grid);
-        const int_t i_blocks = exinfo.i_blocks();
-        const int_t j_blocks = exinfo.j_blocks();
-#pragma omp parallel for collapse(2)
-        for (int_t bj = 0; bj < j_blocks; ++bj) {
-            for (int_t bi = 0; bi < i_blocks; ++bi) {
-                run_mss_functors<MssComponents>(backend::mc{}, local_domain_lists, grid, exinfo.block(bi, bj));
-            }
-        }
+        using stencil_t = meta::list<MssComponents, LocalDomainListArray>;
+        _impl::with_execinfo_mc<stencil_t>(grid, [&](execinfo_mc const &exinfo) {
+#ifdef GT_MC_WORK_STEALING
+            const int_t i_blocks = exinfo.i_blocks();
+            const int_t j_blocks = exinfo.j_blocks();
+            work_stealing_mc(i_blocks * j_blocks, [&](int_t b) {
+                _impl::run_block_mc<MssComponents>(
+                    local_domain_lists, grid, exinfo.block(b % i_blocks, b / i_blocks), epilogue);
+            });
+#else
+#pragma omp parallel
+            _impl::blocks_loop_mc<MssComponents>(local_domain_lists, grid, exinfo, epilogue, std::false_type{});
+#endif
+        });
     }
 
     /**
      * @brief loops over all blocks and execute sequentially all mss functors for each block
+     *
+     * If GT_MC_WORK_STEALING is defined, blocks are distributed by the work-stealing scheduler, otherwise statically.
+     * If GT_MC_AUTOTUNE is defined, the block sizes are tuned during the first runs.
+     * The block epilogue is called after every block (see `_impl::no_block_epilogue`).
      * @tparam MssComponents a meta array with the mss components of all MSS
      */
     template <class MssComponents,
         class LocalDomainListArray,
         class Grid,
+        class BlockEpilogue = _impl::no_block_epilogue,
         enable_if_t<_impl::all_mss_kparallel<MssComponents>::value, int> = 0>
-    void fused_mss_loop(backend::mc, LocalDomainListArray const &local_domain_lists, const Grid &grid) {
+    void fused_mss_loop(backend::mc,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        BlockEpilogue const &epilogue = {}) {
         GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
+        using stencil_t = meta::list<MssComponents, LocalDomainListArray>;
+        _impl::with_execinfo_mc<stencil_t>(grid, [&](execinfo_mc const &exinfo) {
+#ifdef GT_MC_WORK_STEALING
+            const int_t i_blocks = exinfo.i_blocks();
+            const int_t j_blocks = exinfo.j_blocks();
+            const int_t k_first = grid.k_min();
+            const int_t k_last = grid.k_max();
+            const int_t k_size = k_last - k_first + 1;
+            work_stealing_mc(i_blocks * k_size * j_blocks, [&](int_t b) {
+                const int_t bi = b % i_blocks;
+                const int_t k = b / i_blocks % k_size + k_first;
+                const int_t bj = b / (i_blocks * k_size);
+                _impl::run_block_mc<MssComponents>(local_domain_lists, grid, exinfo.block(bi, bj, k), epilogue);
+            });
+#else
+#pragma omp parallel
+            _impl::blocks_loop_mc<MssComponents>(local_domain_lists, grid, exinfo, epilogue, std::true_type{});
+#endif
+        });
+    }
 
-        execinfo_mc exinfo(grid);
-        const int_t i_blocks = exinfo.i_blocks();
-        const int_t j_blocks = exinfo.j_blocks();
-        const int_t k_first = grid.k_min();
-        const int_t k_last = grid.k_max();
-#pragma omp parallel for collapse(3)
-        for (int_t bj = 0; bj < j_blocks; ++bj) {
-            for (int_t k = k_first; k <= k_last; ++k) {
-                for (int_t bi = 0; bi < i_blocks; ++bi) {
-                    run_mss_functors<MssComponents>(backend::mc{}, local_domain_lists, grid, exinfo.block(bi, bj, k));
-                }
-            }
-        }
+    /**
+     * @brief like the above, with the blocks shared among the threads of the enclosing parallel region, which meet at
+     * a barrier at the end (see computation_sequence)
+     *
+     * The default block decomposition is used: autotuning and work stealing both need a parallel region of their own.
+     */
+    template <class MssComponents,
+        class LocalDomainListArray,
+        class Grid,
+        class BlockEpilogue = _impl::no_block_epilogue>
+    void fused_mss_loop(backend::mc,
+        _impl::enclosing_omp_team,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        BlockEpilogue const &epilogue = {}) {
+        GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
+        _impl::blocks_loop_mc<MssComponents>(
+            local_domain_lists, grid, execinfo_mc(grid), epilogue, _impl::all_mss_kparallel<MssComponents>{});
+#pragma omp barrier
     }
 
     /**
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
     std::false_type mss_fuse_esfs(backend::mc);
+
+    /**
+     * @brief determines whether the backend loops can share their work with the threads of an enclosing parallel region
+     * (see `_impl::enclosing_omp_team`).
+     */
+    std::true_type shares_enclosing_omp_team(backend::mc);
+
+    /**
+     * @brief determines whether the backend calls a block epilogue after every block.
+     */
+    std::true_type runs_block_epilogues(backend::mc);
 } // namespace gridtools
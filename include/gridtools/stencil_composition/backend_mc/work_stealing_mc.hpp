@@ -0,0 +1,111 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <omp.h>
+
+#include "../../common/defs.hpp"
+
+/**@file
+ * @brief work-stealing block scheduler for the mc backend
+ */
+namespace gridtools {
+    namespace _impl_work_stealing_mc {
+        /**
+         * @brief Range of block indices [first, last) owned by a single thread.
+         *
+         * Both bounds are packed into a single atomic word, such that the owner (popping from the front) and thieves
+         * (popping from the back) can never take the same block. The range is padded to avoid false sharing between
+         * the ranges of different threads.
+         */
+        class block_range {
+            std::atomic<std::uint64_t> m_range;
+            char m_padding[128 - sizeof(std::atomic<std::uint64_t>)];
+
+            static std::uint64_t pack(std::uint32_t first, std::uint32_t last) {
+                return (std::uint64_t)first << 32 | last;
+            }
+            static std::uint32_t first(std::uint64_t range) { return range >> 32; }
+            static std::uint32_t last(std::uint64_t range) { return range & 0xffffffff; }
+
+          public:
+            block_range() : m_range(0) {}
+
+            void reset(int_t first, int_t last) { m_range.store(pack(first, last), std::memory_order_relaxed); }
+
+            /**
+             * @brief Takes the next block from the front of the range, used by the owning thread.
+             */
+            bool pop_front(int_t &index) {
+                std::uint64_t range = m_range.load(std::memory_order_relaxed);
+                do {
+                    if (first(range) >= last(range))
+                        return false;
+                } while (!m_range.compare_exchange_weak(
+                    range, pack(first(range) + 1, last(range)), std::memory_order_relaxed));
+                index = first(range);
+                return true;
+            }
+
+            /**
+             * @brief Takes the last block from the back of the range, used by stealing threads.
+             */
+            bool pop_back(int_t &index) {
+                std::uint64_t range = m_range.load(std::memory_order_relaxed);
+                do {
+                    if (first(range) >= last(range))
+                        return false;
+                } while (!m_range.compare_exchange_weak(
+                    range, pack(first(range), last(range) - 1), std::memory_order_relaxed));
+                index = last(range) - 1;
+                return true;
+            }
+        };
+    } // namespace _impl_work_stealing_mc
+
+    /**
+     * @brief Executes `f(index)` for all block indices in [0, blocks) inside a single OpenMP parallel region.
+     *
+     * Each thread is seeded with the contiguous chunk of blocks it would get from a static schedule, so blocks are
+     * preferentially processed by the thread that first touched the corresponding memory. A thread that runs out of
+     * work steals single blocks from the back of the other threads' ranges, visiting victims in order of increasing
+     * distance of thread ids. With compact thread binding (e.g. `OMP_PROC_BIND=close`) this means that threads steal
+     * from their own NUMA domain first.
+     *
+     * Every block is executed exactly once and completely by one thread, thus per-thread temporary storage stays
+     * valid.
+     */
+    template <class F>
+    void work_stealing_mc(int_t blocks, F const &f) {
+        std::vector<_impl_work_stealing_mc::block_range> ranges(omp_get_max_threads());
+#pragma omp parallel
+        {
+            const int_t threads = omp_get_num_threads();
+            const int_t thread = omp_get_thread_num();
+            ranges[thread].reset(blocks * thread / threads, blocks * (thread + 1) / threads);
+#pragma omp barrier
+            int_t index;
+            while (ranges[thread].pop_front(index))
+                f(index);
+            for (int_t distance = 1; distance < threads; ++distance) {
+                auto &next = ranges[(thread + distance) % threads];
+                while (next.pop_back(index))
+                    f(index);
+                auto &prev = ranges[(thread - distance + threads) % threads];
+                while (prev.pop_back(index))
+                    f(index);
+            }
+        }
+    }
+} // namespace gridtools
@@ -106,4 +106,15 @@ namespace gridtools {
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
     std::true_type mss_fuse_esfs(backend::naive);
+
+    /**
+     * @brief determines whether the backend loops can share their work with the threads of an enclosing parallel region
+     * (see `_impl::enclosing_omp_team`).
+     */
+    std::false_type shares_enclosing_omp_team(backend::naive);
+
+    /**
+     * @brief determines whether the backend calls a block epilogue after every block.
+     */
+    std::false_type runs_block_epilogues(backend::naive);
 } // namespace gridtools
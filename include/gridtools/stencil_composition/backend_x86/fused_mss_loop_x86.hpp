@@ -23,34 +23,86 @@ namespace gridtools {
         uint_t bi, bj;
     };
 
-    /**
-     * @brief loops over all blocks and execute sequentially all mss functors for each block
-     * @tparam MssComponents a meta array with the mss components of all MSS
-     */
-    template <class MssComponents, class LocalDomainListArray, class Grid>
-    void fused_mss_loop(backend::x86, LocalDomainListArray const &local_domain_lists, const Grid &grid) {
-        GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
-        GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
-        uint_t n = grid.i_high_bound() - grid.i_low_bound();
-        uint_t m = grid.j_high_bound() - grid.j_low_bound();
+    namespace _impl {
+        /**
+         * @brief shares the blocks among the threads of the current team, without a barrier
+         */
+        template <class MssComponents, class LocalDomainListArray, class Grid, class BlockEpilogue>
+        void blocks_loop_x86(
+            LocalDomainListArray const &local_domain_lists, const Grid &grid, BlockEpilogue const &epilogue) {
+            uint_t n = grid.i_high_bound() - grid.i_low_bound();
+            uint_t m = grid.j_high_bound() - grid.j_low_bound();
 
-        uint_t NBI = n / block_i_size(backend::x86{});
-        uint_t NBJ = m / block_j_size(backend::x86{});
+            uint_t NBI = n / block_i_size(backend::x86{});
+            uint_t NBJ = m / block_j_size(backend::x86{});
 
-#pragma omp parallel
-        {
-#pragma omp for nowait
+#pragma omp for schedule(static) nowait
             for (uint_t bi = 0; bi <= NBI; ++bi) {
                 for (uint_t bj = 0; bj <= NBJ; ++bj) {
                     run_mss_functors<MssComponents>(
                         backend::x86{}, local_domain_lists, grid, execution_info_x86{bi, bj});
+                    const uint_t i_first = grid.i_low_bound() + bi * block_i_size(backend::x86{});
+                    const uint_t j_first = grid.j_low_bound() + bj * block_j_size(backend::x86{});
+                    const int_t i_last = bi == NBI ? grid.i_high_bound() : i_first + block_i_size(backend::x86{}) - 1u;
+                    const int_t j_last = bj == NBJ ? grid.j_high_bound() : j_first + block_j_size(backend::x86{}) - 1u;
+                    epilogue(i_first, i_last, j_first, j_last, grid.k_min(), grid.k_max());
                 }
             }
         }
+    } // namespace _impl
+
+    /**
+     * @brief loops over all blocks and execute sequentially all mss functors for each block
+     *
+     * The block epilogue is called after every block (see `_impl::no_block_epilogue`).
+     * @tparam MssComponents a meta array with the mss components of all MSS
+     */
+    template <class MssComponents,
+        class LocalDomainListArray,
+        class Grid,
+        class BlockEpilogue = _impl::no_block_epilogue>
+    void fused_mss_loop(backend::x86,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        BlockEpilogue const &epilogue = {}) {
+        GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
+        GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
+#pragma omp parallel
+        _impl::blocks_loop_x86<MssComponents>(local_domain_lists, grid, epilogue);
+    }
+
+    /**
+     * @brief like the above, with the blocks shared among the threads of the enclosing parallel region, which meet at
+     * a barrier at the end (see computation_sequence)
+     */
+    template <class MssComponents,
+        class LocalDomainListArray,
+        class Grid,
+        class BlockEpilogue = _impl::no_block_epilogue>
+    void fused_mss_loop(backend::x86,
+        _impl::enclosing_omp_team,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        BlockEpilogue const &epilogue = {}) {
+        GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
+        GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
+        _impl::blocks_loop_x86<MssComponents>(local_domain_lists, grid, epilogue);
+#pragma omp barrier
     }
 
     /**
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
     constexpr std::false_type mss_fuse_esfs(backend::x86) { return {}; }
+
+    /**
+     * @brief determines whether the backend loops can share their work with the threads of an enclosing parallel region
+     * (see `_impl::enclosing_omp_team`).
+     */
+    constexpr std::true_type shares_enclosing_omp_team(backend::x86) { return {}; }
+
+    /**
+     * @brief determines whether the backend calls a block epilogue after every block.
+     */
+    constexpr std::true_type runs_block_epilogues(backend::x86) { return {}; }
 } // namespace gridtools
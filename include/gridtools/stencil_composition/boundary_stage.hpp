@@ -0,0 +1,286 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+
+#include "../boundary_conditions/direction.hpp"
+#include "../common/array.hpp"
+#include "../common/defs.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "../common/hymap.hpp"
+#include "../common/tuple_util.hpp"
+#include "../meta.hpp"
+#include "arg.hpp"
+#include "compute_extents_metafunctions.hpp"
+#include "dim.hpp"
+#include "sid/concept.hpp"
+
+/**
+ * @file
+ * Boundary conditions applied by the backend as the final stage of a computation, see `make_boundary_stage`.
+ */
+
+namespace gridtools {
+
+    /**
+     *  A boundary condition attached to the placeholders of a computation, created by `make_boundary_stage`.
+     */
+    template <class BoundaryFunction, class... Placeholders>
+    struct boundary_stage {
+        using placeholders_t = meta::list<Placeholders...>;
+
+        BoundaryFunction m_boundary_function;
+    };
+
+    template <class T>
+    struct is_boundary_stage : std::false_type {};
+
+    template <class BoundaryFunction, class... Placeholders>
+    struct is_boundary_stage<boundary_stage<BoundaryFunction, Placeholders...>> : std::true_type {};
+
+    /**
+     *  Attaches a boundary condition to the output placeholder `Placeholder` of a computation, to be passed to
+     *  `make_computation` together with the multistages:
+     *
+     *  \code
+     *  make_computation<backend_t>(grid, make_multistage(...), make_boundary_stage(copy_boundary(), p_out, p_in));
+     *  \endcode
+     *
+     *  The boundary function has the interface of the ones of `boundary` (e.g. `copy_boundary`, `value_boundary` and
+     *  `zero_boundary`) and is called with the fields of the placeholders, in the given order, on the i-j halo of the
+     *  grid. The mc and x86 backends apply it to the halo next to every block right after the block is computed, while
+     *  the data is still in cache, instead of in a separate pass. The naive backend applies it after the stages.
+     *
+     *  The boundary function may only access the point it is called for, and the placeholders must not be read with
+     *  a non zero horizontal extent by the stages of the computation (which would read the halo while it is being
+     *  written), this is checked by `make_computation`. Boundary stages are not supported by the cuda backend.
+     */
+    template <class BoundaryFunction, class Placeholder, class... Placeholders>
+    boundary_stage<BoundaryFunction, Placeholder, Placeholders...> make_boundary_stage(
+        BoundaryFunction const &boundary_function, Placeholder, Placeholders...) {
+        GT_STATIC_ASSERT((conjunction<is_plh<Placeholder>, is_plh<Placeholders>...>::value),
+            "make_boundary_stage args should be placeholders");
+        GT_STATIC_ASSERT(!(disjunction<is_tmp_arg<Placeholder>, is_tmp_arg<Placeholders>...>::value),
+            "boundary stages can not be attached to temporaries");
+        return {boundary_function};
+    }
+
+    namespace boundary_stage_impl_ {
+        template <class ExtentMap>
+        struct has_zero_horizontal_extent_f {
+            template <class Placeholder, class Extent = GT_META_CALL(lookup_extent_map, (ExtentMap, Placeholder))>
+            GT_META_DEFINE_ALIAS(apply,
+                bool_constant,
+                (Extent::iminus::value == 0 && Extent::iplus::value == 0 && Extent::jminus::value == 0 &&
+                    Extent::jplus::value == 0));
+        };
+    } // namespace boundary_stage_impl_
+
+    /**
+     *  Whether the stages of a computation with the given extent map (see `get_extent_map`) read none of the
+     *  placeholders of the boundary stages with a non zero horizontal extent.
+     */
+    template <class ExtentMap, class... BoundaryStages>
+    GT_META_DEFINE_ALIAS(boundary_stages_have_zero_extents,
+        meta::all_of,
+        (boundary_stage_impl_::has_zero_horizontal_extent_f<ExtentMap>::template apply,
+            GT_META_CALL(meta::concat, (meta::list<>, typename BoundaryStages::placeholders_t...))));
+
+    namespace boundary_stage_impl_ {
+        /**
+         *  A field of a local domain with the interface of a data view: `field(i, j, k)` is the element (i, j, k) of
+         *  the storage.
+         */
+        template <class Ptr, class Strides>
+        struct field {
+            using data_t = typename std::remove_pointer<Ptr>::type;
+
+            Ptr m_ptr;
+            Strides m_strides;
+
+            data_t &operator()(int_t i, int_t j, int_t k) const {
+                return *(m_ptr + i * sid::get_stride<dim::i>(m_strides) + j * sid::get_stride<dim::j>(m_strides) +
+                         k * sid::get_stride<dim::k>(m_strides));
+            }
+        };
+
+        template <class Placeholder, class DataStore = typename Placeholder::data_store_t>
+        GT_META_DEFINE_ALIAS(get_field,
+            meta::id,
+            (field<GT_META_CALL(sid::ptr_type, DataStore), GT_META_CALL(sid::strides_type, DataStore)>));
+
+        /// sets the field from the first local domain that contains the placeholder
+        template <class Placeholder>
+        struct set_field_f {
+            GT_META_CALL(get_field, Placeholder) & m_field;
+            bool &m_found;
+
+            template <class LocalDomain>
+            void operator()(LocalDomain const &local_domain) const {
+                set(local_domain, meta::st_contains<typename LocalDomain::esf_args_t, Placeholder>{});
+            }
+
+          private:
+            template <class LocalDomain>
+            void set(LocalDomain const &local_domain, std::true_type) const {
+                if (m_found)
+                    return;
+                using strides_kind_t = GT_META_CALL(sid::strides_kind, typename Placeholder::data_store_t);
+                m_field = {host::at_key<Placeholder>(local_domain.m_ptr_holder_map)(),
+                    host::at_key<strides_kind_t>(local_domain.m_strides_map)};
+                m_found = true;
+            }
+
+            template <class LocalDomain>
+            void set(LocalDomain const &, std::false_type) const {}
+        };
+
+        template <class Placeholder, class LocalDomains>
+        GT_META_CALL(get_field, Placeholder)
+        make_field(LocalDomains const &local_domains) {
+            GT_META_CALL(get_field, Placeholder) res;
+            bool found = false;
+            tuple_util::for_each(set_field_f<Placeholder>{res, found}, local_domains);
+            assert(found);
+            return res;
+        }
+
+        /**
+         *  The part [low, high] of the halo in the given direction of one dimension that is next to the block
+         *  [first, last] of the compute domain, false if the block is not at the boundary in this direction.
+         */
+        inline bool halo_range(
+            sign direction, halo_descriptor const &halo, int_t first, int_t last, int_t &low, int_t &high) {
+            switch (direction) {
+            case minus_:
+                low = halo.loop_low_bound_outside(minus_);
+                high = halo.loop_high_bound_outside(minus_);
+                return first == static_cast<int_t>(halo.begin()) && low <= high;
+            case plus_:
+                low = halo.loop_low_bound_outside(plus_);
+                high = halo.loop_high_bound_outside(plus_);
+                return last == static_cast<int_t>(halo.end()) && low <= high;
+            default:
+                low = first;
+                high = last;
+                return true;
+            }
+        }
+
+        /// a boundary stage with the fields of its placeholders
+        template <class BoundaryFunction, class Fields>
+        struct bound_stage;
+
+        template <class BoundaryFunction, class... Fields>
+        struct bound_stage<BoundaryFunction, std::tuple<Fields...>> {
+            BoundaryFunction m_boundary_function;
+            std::tuple<Fields...> m_fields;
+
+            template <class Direction>
+            void apply(array<halo_descriptor, 2> const &halos,
+                int_t i_first,
+                int_t i_last,
+                int_t j_first,
+                int_t j_last,
+                int_t k_first,
+                int_t k_last) const {
+                int_t i_low, i_high, j_low, j_high;
+                if (!halo_range(Direction::i, halos[0], i_first, i_last, i_low, i_high) ||
+                    !halo_range(Direction::j, halos[1], j_first, j_last, j_low, j_high))
+                    return;
+                apply_impl<Direction>(
+                    i_low, i_high, j_low, j_high, k_first, k_last, meta::make_index_sequence<sizeof...(Fields)>{});
+            }
+
+          private:
+            template <class Direction, size_t... Is>
+            void apply_impl(int_t i_low,
+                int_t i_high,
+                int_t j_low,
+                int_t j_high,
+                int_t k_first,
+                int_t k_last,
+                meta::index_sequence<Is...>) const {
+                for (int_t j = j_low; j <= j_high; ++j)
+                    for (int_t k = k_first; k <= k_last; ++k)
+                        for (int_t i = i_low; i <= i_high; ++i)
+                            m_boundary_function(Direction(), std::get<Is>(m_fields)..., i, j, k);
+            }
+        };
+
+        template <class LocalDomains>
+        struct bind_stage_f {
+            LocalDomains const &m_local_domains;
+
+            template <class BoundaryFunction, class... Placeholders>
+            bound_stage<BoundaryFunction, std::tuple<GT_META_CALL(get_field, Placeholders)...>> operator()(
+                boundary_stage<BoundaryFunction, Placeholders...> const &stage) const {
+                return {stage.m_boundary_function,
+                    std::make_tuple(make_field<Placeholders>(m_local_domains)...)};
+            }
+        };
+
+        /**
+         *  The block epilogue of the backends that applies the boundary stages to the halo next to the block
+         *  [i_first, i_last] x [j_first, j_last] x [k_first, k_last] of the compute domain (bounds included).
+         */
+        template <class BoundStages>
+        struct boundary_epilogue {
+            array<halo_descriptor, 2> m_halos;
+            BoundStages m_stages;
+
+            void operator()(
+                int_t i_first, int_t i_last, int_t j_first, int_t j_last, int_t k_first, int_t k_last) const {
+                tuple_util::for_each(
+                    apply_f{m_halos, i_first, i_last, j_first, j_last, k_first, k_last}, m_stages);
+            }
+
+          private:
+            struct apply_f {
+                array<halo_descriptor, 2> const &m_halos;
+                int_t m_i_first, m_i_last, m_j_first, m_j_last, m_k_first, m_k_last;
+
+                template <class Stage>
+                void operator()(Stage const &stage) const {
+                    apply<direction<minus_, minus_, zero_>>(stage);
+                    apply<direction<minus_, zero_, zero_>>(stage);
+                    apply<direction<minus_, plus_, zero_>>(stage);
+                    apply<direction<zero_, minus_, zero_>>(stage);
+                    apply<direction<zero_, plus_, zero_>>(stage);
+                    apply<direction<plus_, minus_, zero_>>(stage);
+                    apply<direction<plus_, zero_, zero_>>(stage);
+                    apply<direction<plus_, plus_, zero_>>(stage);
+                }
+
+                template <class Direction, class Stage>
+                void apply(Stage const &stage) const {
+                    stage.template apply<Direction>(
+                        m_halos, m_i_first, m_i_last, m_j_first, m_j_last, m_k_first, m_k_last);
+                }
+            };
+        };
+    } // namespace boundary_stage_impl_
+
+    /**
+     *  The block epilogue that applies the boundary stages on the fields of the local domains. The halos are the
+     *  i and j halos of `grid`.
+     */
+    template <class Grid, class... BoundaryStages, class LocalDomains>
+    auto make_boundary_epilogue(
+        Grid const &grid, std::tuple<BoundaryStages...> const &stages, LocalDomains const &local_domains)
+        -> boundary_stage_impl_::boundary_epilogue<decltype(
+            tuple_util::transform(boundary_stage_impl_::bind_stage_f<LocalDomains>{local_domains}, stages))> {
+        return {{grid.direction_i(), grid.direction_j()},
+            tuple_util::transform(boundary_stage_impl_::bind_stage_f<LocalDomains>{local_domains}, stages)};
+    }
+} // namespace gridtools
@@ -21,6 +21,7 @@
 #include "../../common/generic_metafunctions/for_each.hpp"
 #include "../../common/host_device.hpp"
 #include "../execution_types.hpp"
+#include "./cache_storage.hpp"
 
 namespace gridtools {
     namespace _impl {
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -19,6 +20,7 @@
 #include "accessor_intent.hpp"
 #include "arg.hpp"
 #include "extent.hpp"
+#include "traffic_model.hpp"
 
 namespace gridtools {
 
@@ -34,6 +36,16 @@ namespace gridtools {
                 }
             };
 
+            template <class Obj>
+            struct prepare_f {
+                Obj &m_obj;
+
+                template <class... Args>
+                void operator()(Args &&... args) const {
+                    m_obj.prepare(wstd::forward<Args>(args)...);
+                }
+            };
+
             template <typename Arg>
             struct iface_arg {
                 virtual ~iface_arg() = default;
@@ -65,13 +77,23 @@ namespace gridtools {
 
         using arg_storage_pair_crefs_t = std::tuple<arg_storage_pair<Args, typename Args::data_store_t> const &...>;
 
+      public:
+        /// The type of the functions passed to `setup_prepared_run`, they take a functor running the backend loops.
+        using setup_fun_t = std::function<void(std::function<void()> const &)>;
+
+      private:
+
         struct iface : virtual _impl::computation_detail::iface_arg<Args>... {
             virtual ~iface() = default;
             virtual void run(arg_storage_pair_crefs_t const &) = 0;
+            virtual void prepare(arg_storage_pair_crefs_t const &) = 0;
+            virtual void run_prepared() = 0;
+            virtual void setup_prepared_run(setup_fun_t const &) = 0;
             virtual std::string print_meter() const = 0;
             virtual double get_time() const = 0;
             virtual size_t get_count() const = 0;
             virtual void reset_meter() = 0;
+            virtual traffic_model get_traffic_model() const = 0;
         };
 
         template <class Obj>
@@ -83,10 +105,16 @@ namespace gridtools {
             void run(arg_storage_pair_crefs_t const &args) override {
                 tuple_util::apply(_impl::computation_detail::run_f<Obj>{m_obj}, args);
             }
+            void prepare(arg_storage_pair_crefs_t const &args) override {
+                tuple_util::apply(_impl::computation_detail::prepare_f<Obj>{m_obj}, args);
+            }
+            void run_prepared() override { m_obj.run_prepared(); }
+            void setup_prepared_run(setup_fun_t const &fun) override { m_obj.setup_prepared_run(fun); }
             std::string print_meter() const override { return m_obj.print_meter(); }
             double get_time() const override { return m_obj.get_time(); }
             size_t get_count() const override { return m_obj.get_count(); }
             void reset_meter() override { m_obj.reset_meter(); }
+            traffic_model get_traffic_model() const override { return m_obj.get_traffic_model(); }
         };
 
         std::unique_ptr<iface> m_impl;
@@ -109,6 +137,27 @@ namespace gridtools {
             m_impl->run(permute_to<arg_storage_pair_crefs_t>(std::make_tuple(std::cref(args)...)));
         }
 
+        /**
+         * Binds the storages to be used by `run_prepared`. The host side setup of the run, like filling the pointers
+         * to the storages, is done once here instead of on every run.
+         */
+        template <class... SomeArgs, class... SomeDataStores>
+        typename std::enable_if<sizeof...(SomeArgs) == sizeof...(Args)>::type prepare(
+            arg_storage_pair<SomeArgs, SomeDataStores> const &... args) {
+            m_impl->prepare(permute_to<arg_storage_pair_crefs_t>(std::make_tuple(std::cref(args)...)));
+        }
+
+        /**
+         * Runs the computation on the storages bound by the last call of `prepare`.
+         */
+        void run_prepared() { m_impl->run_prepared(); }
+
+        /**
+         * Does the host side part of `run_prepared` and calls `fun` with a functor running the backend loops, that can
+         * be called from all threads of a parallel region (see computation_sequence).
+         */
+        void setup_prepared_run(setup_fun_t const &fun) { m_impl->setup_prepared_run(fun); }
+
         std::string print_meter() const { return m_impl->print_meter(); }
 
         double get_time() const { return m_impl->get_time(); }
@@ -117,6 +166,9 @@ namespace gridtools {
 
         void reset_meter() { m_impl->reset_meter(); }
 
+        /// The minimum memory traffic and the operation count of a run, see `traffic_model`.
+        traffic_model get_traffic_model() const { return m_impl->get_traffic_model(); }
+
         template <class Arg>
         enable_if_t<meta::st_contains<meta::list<Args...>, Arg>::value, rt_extent> get_arg_extent(Arg) const {
             return static_cast<_impl::computation_detail::iface_arg<Arg> const &>(*m_impl).get_arg_extent(Arg());
@@ -0,0 +1,77 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace gridtools {
+
+    /**
+     * A sequence of prepared computations (see `computation::prepare`) that are run one after the other inside of a
+     * single OpenMP parallel region.
+     *
+     * The host side setup of all the computations is done first, then the threads are forked once and run the backend
+     * loops of the computations in order, with a barrier after each computation. The mc and x86 backends share the
+     * blocks of each computation among the threads of the team with a static schedule, so for computations on the same
+     * grid every thread keeps working on the same blocks and finds their data in its cache. With the other backends
+     * each computation is run by a single thread of the team.
+     *
+     * The computations are referred to, not owned, by the sequence.
+     */
+    class computation_sequence {
+        using loop_t = std::function<void()>;
+        using setup_fun_t = std::function<void(loop_t const &)>;
+        using setup_t = std::function<void(setup_fun_t const &)>;
+
+        std::vector<setup_t> m_setups;
+        std::vector<loop_t> m_loops;
+
+        // the setups are nested, so that the storages of all the computations are ready while the loops run
+        void setup_and_run(std::size_t i) {
+            if (i == m_setups.size()) {
+#pragma omp parallel
+                for (auto const &loop : m_loops)
+                    loop();
+                return;
+            }
+            m_setups[i]([this, i](loop_t const &loop) {
+                m_loops.push_back(loop);
+                setup_and_run(i + 1);
+            });
+        }
+
+      public:
+        template <class Comp>
+        computation_sequence &add(Comp &comp) {
+            m_setups.push_back([&comp](setup_fun_t const &fun) { comp.setup_prepared_run(fun); });
+            return *this;
+        }
+
+        std::size_t size() const { return m_setups.size(); }
+
+        void run() {
+            m_loops.clear();
+            setup_and_run(0);
+        }
+    };
+
+    /**
+     * Runs the given prepared computations in order inside of a single OpenMP parallel region, see
+     * `computation_sequence`.
+     */
+    template <class... Comps>
+    void run_all(Comps &... comps) {
+        computation_sequence sequence;
+        (void)(int[]){0, ((void)sequence.add(comps), 0)...};
+        sequence.run();
+    }
+} // namespace gridtools
@@ -76,6 +76,17 @@ namespace gridtools {
         class AllRwArgs = GT_META_CALL(meta::transform, (meta::first, AllRwItems))>
     GT_META_DEFINE_ALIAS(compute_readwrite_args, meta::dedup, AllRwArgs);
 
+    /**
+     * Compute a list of all args specified by the user that are read by at least one ESF
+     */
+    template <class Esfs,
+        class ItemLists = GT_META_CALL(meta::transform, (esf_metafunctions_impl_::get_items, Esfs)),
+        class AllItems = GT_META_CALL(meta::flatten, ItemLists),
+        class AllInItems = GT_META_CALL(
+            meta::filter, (esf_metafunctions_impl_::has_intent<intent::in>::apply, AllItems)),
+        class AllInArgs = GT_META_CALL(meta::transform, (meta::first, AllInItems))>
+    GT_META_DEFINE_ALIAS(compute_read_args, meta::dedup, AllInArgs);
+
     // Takes a list of esfs and independent_esf and produces a list of esfs, with the independent unwrapped
     template <class Esfs,
         class EsfLists = GT_META_CALL(meta::transform, (esf_metafunctions_impl_::tuple_from_esf, Esfs))>
@@ -12,6 +12,8 @@
 #include <cassert>
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -21,12 +23,14 @@
 #include "../../common/split_args.hpp"
 #include "../../common/tuple_util.hpp"
 #include "../../meta.hpp"
+#include "../../storage/data_store.hpp"
 #include "../arg.hpp"
 #include "../esf_fwd.hpp"
 #include "../esf_metafunctions.hpp"
 #include "../fused_mss_loop.hpp"
 #include "../independent_esf.hpp"
 #include "../intermediate.hpp"
+#include "../intermediate_impl.hpp"
 #include "../mss.hpp"
 
 namespace gridtools {
@@ -243,18 +247,76 @@ namespace gridtools {
                 (convert_mss_descriptor_f<ExpandFactor>::template apply, MssDescriptors));
 
             template <class Intermediate>
-            struct run_f {
+            struct local_domains_f {
                 Intermediate &m_intermediate;
                 template <class... Args>
-                void operator()(Args const &... args) const {
-                    m_intermediate.run(args...);
+                typename Intermediate::local_domains_t operator()(Args const &... args) const {
+                    return m_intermediate.local_domains(args...);
                 }
-                using result_type = void;
+                using result_type = typename Intermediate::local_domains_t;
             };
 
             template <class Intermediate, class Args>
-            void invoke_run(Intermediate &intermediate, Args &&args) {
-                tuple_util::apply(run_f<Intermediate>{intermediate}, wstd::forward<Args>(args));
+            typename Intermediate::local_domains_t make_local_domains(Intermediate &intermediate, Args &&args) {
+                return tuple_util::apply(local_domains_f<Intermediate>{intermediate}, wstd::forward<Args>(args));
+            }
+
+            inline void push_storage(std::vector<void const *> &dst, std::shared_ptr<void const> const &src) {
+                dst.push_back(src.get());
+            }
+
+            inline void push_storage(
+                std::vector<std::shared_ptr<void const>> &dst, std::shared_ptr<void const> const &src) {
+                dst.push_back(src);
+            }
+
+            /// Collects the storages of all the data stores of the given arg_storage_pairs, in order. The data stores
+            /// are synced to the target if needed.
+            template <class Ptr>
+            struct collect_storages_f {
+                std::vector<Ptr> &m_dst;
+
+                template <class Storage, class StorageInfo>
+                void operator()(data_store<Storage, StorageInfo> const &src) const {
+                    sync_data_store_f{}(src);
+                    push_storage(m_dst, src.get_storage_ptr());
+                }
+
+                template <class DataStore>
+                void operator()(std::vector<DataStore> const &src) const {
+                    for (auto const &data_store : src)
+                        (*this)(data_store);
+                }
+
+                template <class Arg, class DataStore>
+                void operator()(arg_storage_pair<Arg, DataStore> const &src) const {
+                    (*this)(src.m_value);
+                }
+            };
+
+            using loops_t = std::vector<std::function<void()>>;
+
+            // stores the backend loops of an intermediate and continues the setup with the next one
+            template <class Then>
+            struct push_loop_f {
+                loops_t &m_loops;
+                Then m_then;
+
+                template <class Loop>
+                void operator()(Loop const &loop) const {
+                    m_loops.push_back(loop);
+                    m_then();
+                }
+            };
+
+            template <class Then>
+            push_loop_f<Then> push_loop(loops_t &loops, Then then) {
+                return {loops, then};
+            }
+
+            /// The largest power of two smaller than `n`, or zero if there is none.
+            constexpr size_t largest_power_of_two_below(size_t n, size_t p = 1) {
+                return 2 * p < n ? largest_power_of_two_below(n, 2 * p) : p < n ? p : 0;
             }
         } // namespace expand_detail
     }     // namespace _impl
@@ -273,9 +335,14 @@ namespace gridtools {
        4, we'll execute 5 stencil with a "vector width" of 4, and one stencil with a "vector width"
        of 3 (23%4).
 
-       This object contains two objects of @ref gridtools::intermediate type, one with a vector width
-       corresponding to the expand factor defined by the user (4 in the previous example), and another
-       one with a vector width of expand_factor%total_parameters (3 in the previous example).
+       This object contains an object of @ref gridtools::intermediate type with a vector width
+       corresponding to the expand factor defined by the user (4 in the previous example), and one
+       for each power of two smaller than the expand factor (2 and 1 in the previous example). The
+       remainder is processed by the binary decomposition of its length (2 + 1 in the previous example),
+       so that it takes at most log2(expand_factor) sweeps over the grid.
+
+       The local domains of all the chunks are built once and reused by the following runs, as long as the
+       same storages are passed. They are built again as soon as any storage changes.
      */
     template <size_t ExpandFactor,
         bool IsStateful,
@@ -304,9 +371,94 @@ namespace gridtools {
         //
         converted_intermediate<ExpandFactor> m_intermediate;
 
-        /// If the actual size of storages is not divided by `ExpandFactor`, this `intermediate` will process
-        /// reminder.
-        converted_intermediate<1> m_intermediate_remainder;
+        /// The local domains of the chunks processed by `m_intermediate`, one per chunk.
+        //
+        std::vector<typename converted_intermediate<ExpandFactor>::local_domains_t> m_local_domains;
+
+        /// The storages the local domains were built for. They are kept alive, so that a new storage can not
+        /// reuse the address of one of them.
+        //
+        std::vector<std::shared_ptr<void const>> m_storages;
+        bool m_local_domains_built = false;
+
+        /// The addresses of the storages passed to the current run, the buffer is reused across runs.
+        //
+        std::vector<void const *> m_storage_addresses;
+
+        /// Intermediates for the chunks of size `ChunkSize`, `ChunkSize / 2`, ..., 1 that process the remainder.
+        template <size_t ChunkSize, class = void>
+        struct remainder_intermediates {
+            converted_intermediate<ChunkSize> m_intermediate;
+            typename converted_intermediate<ChunkSize>::local_domains_t m_local_domains;
+            bool m_enabled = false;
+            remainder_intermediates<ChunkSize / 2> m_next;
+
+            template <class NonExpandableBoundArgStoragePairRefs>
+            remainder_intermediates(Grid const &grid, NonExpandableBoundArgStoragePairRefs const &arg_refs)
+                : m_intermediate(grid, arg_refs, false), m_next(grid, arg_refs) {}
+
+            template <class PlainArgs, class ExpandableArgs>
+            void update_local_domains(
+                size_t offset, size_t size, PlainArgs const &plain_args, ExpandableArgs const &expandable_args) {
+                m_enabled = size - offset >= ChunkSize;
+                if (m_enabled) {
+                    auto converted_args =
+                        _impl::expand_detail::convert_arg_storage_pairs<ChunkSize>(offset, expandable_args);
+                    m_local_domains = _impl::expand_detail::make_local_domains(
+                        m_intermediate, tuple_util::flatten(std::tie(plain_args, converted_args)));
+                    offset += ChunkSize;
+                }
+                m_next.update_local_domains(offset, size, plain_args, expandable_args);
+            }
+
+            void run() {
+                if (m_enabled)
+                    m_intermediate.run_local_domains(m_local_domains);
+                m_next.run();
+            }
+
+            void add_traffic_model(traffic_model &model) const {
+                if (m_enabled)
+                    model += m_intermediate.get_traffic_model();
+                m_next.add_traffic_model(model);
+            }
+
+            template <class Then>
+            void setup_runs(_impl::expand_detail::loops_t &loops, Then const &then) {
+                if (m_enabled)
+                    m_intermediate.setup_local_domains_run(m_local_domains,
+                        _impl::expand_detail::push_loop(loops, [&] { m_next.setup_runs(loops, then); }));
+                else
+                    m_next.setup_runs(loops, then);
+            }
+        };
+
+        template <class Dummy>
+        struct remainder_intermediates<0, Dummy> {
+            template <class NonExpandableBoundArgStoragePairRefs>
+            remainder_intermediates(Grid const &, NonExpandableBoundArgStoragePairRefs const &) {}
+
+            template <class PlainArgs, class ExpandableArgs>
+            void update_local_domains(size_t, size_t, PlainArgs const &, ExpandableArgs const &) {}
+
+            void run() {}
+
+            void add_traffic_model(traffic_model &) const {}
+
+            template <class Then>
+            void setup_runs(_impl::expand_detail::loops_t &, Then const &then) {
+                then();
+            }
+        };
+
+        /// If the actual size of storages is not divided by `ExpandFactor`, these `intermediate`s will process
+        /// the reminder.
+        remainder_intermediates<_impl::expand_detail::largest_power_of_two_below(ExpandFactor)>
+            m_intermediate_remainder;
+
+        /// Binds the storages given to `prepare`.
+        //
+        std::function<void(intermediate_expand &)> m_bind_prepared_storages;
 
         typename timer_traits<Backend>::timer_type m_meter;
 
@@ -315,49 +467,148 @@ namespace gridtools {
             std::pair<ExpandableBoundArgStoragePairRefs, NonExpandableBoundArgStoragePairRefs> &&arg_refs)
             // expandable arg_storage_pairs are kept as a class member until run will be called.
             : m_expandable_bound_arg_storage_pairs(wstd::move(arg_refs.first)),
-              // plain arg_storage_pairs are bound to both intermediates;
-              m_intermediate(grid, arg_refs.second, false), m_intermediate_remainder(grid, arg_refs.second, false),
+              // plain arg_storage_pairs are bound to all intermediates;
+              m_intermediate(grid, arg_refs.second, false), m_intermediate_remainder(grid, arg_refs.second),
               m_meter("NoName") {}
 
-      public:
-        template <class BoundArgStoragePairsRefs>
-        intermediate_expand(Grid const &grid, BoundArgStoragePairsRefs &&arg_storage_pairs)
-            // public constructor splits given ard_storage_pairs to expandable and plain ones and delegates to the
-            // private constructor.
-            : intermediate_expand(
-                  grid, split_args_tuple<_impl::expand_detail::is_expandable>(wstd::move(arg_storage_pairs))) {}
+        /// Returns true if the given arg_storage_pairs refer to other storages than the ones of the local domains.
+        template <class PlainArgs, class ExpandableArgs>
+        bool storages_changed(PlainArgs const &plain_args, ExpandableArgs const &expandable_args) {
+            m_storage_addresses.clear();
+            _impl::expand_detail::collect_storages_f<void const *> collect{m_storage_addresses};
+            tuple_util::for_each(collect, plain_args);
+            tuple_util::for_each(collect, expandable_args);
+            if (m_storage_addresses.size() != m_storages.size())
+                return true;
+            for (size_t i = 0; i != m_storages.size(); ++i)
+                if (m_storage_addresses[i] != m_storages[i].get())
+                    return true;
+            return false;
+        }
 
-        template <class... Args, class... DataStores>
-        void run(arg_storage_pair<Args, DataStores> const &... args) {
-            m_meter.start();
-            // split arguments to expandable and plain arg_storage_pairs
-            auto arg_groups = split_args<_impl::expand_detail::is_expandable>(args...);
-            auto bound_expandable_arg_refs = tuple_util::transform(identity{}, m_expandable_bound_arg_storage_pairs);
-            // concatenate expandable portion of arguments with the refs to bound expandable ard_storage_pairs
-            auto expandable_args = std::tuple_cat(wstd::move(bound_expandable_arg_refs), wstd::move(arg_groups.first));
-            const auto &plain_args = arg_groups.second;
+        template <class PlainArgs, class ExpandableArgs>
+        void update_local_domains(PlainArgs const &plain_args, ExpandableArgs const &expandable_args) {
+            m_storages.clear();
+            _impl::expand_detail::collect_storages_f<std::shared_ptr<void const>> collect{m_storages};
+            tuple_util::for_each(collect, plain_args);
+            tuple_util::for_each(collect, expandable_args);
             // extract size from the vectors within expandable args.
             // if vectors are not of the same length assert within `get_expandable_size` fails.
             size_t size = _impl::expand_detail::get_expandable_size(expandable_args);
             size_t offset = 0;
+            m_local_domains.clear();
             for (; size - offset >= ExpandFactor; offset += ExpandFactor) {
                 // form the chunks from expandable_args with the given offset
                 auto converted_args =
                     _impl::expand_detail::convert_arg_storage_pairs<ExpandFactor>(offset, expandable_args);
                 // concatenate that chunk with the plain portion of the arguments
-                // and invoke the `run` of the `m_intermediate`.
-                _impl::expand_detail::invoke_run(
-                    m_intermediate, tuple_util::flatten(std::tie(plain_args, converted_args)));
+                // and build the local domains of `m_intermediate` for it.
+                m_local_domains.push_back(_impl::expand_detail::make_local_domains(
+                    m_intermediate, tuple_util::flatten(std::tie(plain_args, converted_args))));
             }
-            // process the reminder the same way
-            for (; offset < size; ++offset) {
-                auto converted_args = _impl::expand_detail::convert_arg_storage_pairs<1>(offset, expandable_args);
-                _impl::expand_detail::invoke_run(
-                    m_intermediate_remainder, tuple_util::flatten(std::tie(plain_args, converted_args)));
+            // the reminder is split the same way, in chunks of decreasing powers of two
+            m_intermediate_remainder.update_local_domains(offset, size, plain_args, expandable_args);
+            m_local_domains_built = true;
+        }
+
+        /// Updates the local domains for the given storages if they have changed.
+        template <class... Args, class... DataStores>
+        void bind_storages(arg_storage_pair<Args, DataStores> const &... args) {
+            // split arguments to expandable and plain arg_storage_pairs
+            auto arg_groups = split_args<_impl::expand_detail::is_expandable>(args...);
+            auto bound_expandable_arg_refs = tuple_util::transform(identity{}, m_expandable_bound_arg_storage_pairs);
+            // concatenate expandable portion of arguments with the refs to bound expandable ard_storage_pairs
+            auto expandable_args = std::tuple_cat(wstd::move(bound_expandable_arg_refs), wstd::move(arg_groups.first));
+            const auto &plain_args = arg_groups.second;
+            // the local domains are only built again if any storage has changed since the last run
+            if (storages_changed(plain_args, expandable_args) || !m_local_domains_built)
+                update_local_domains(plain_args, expandable_args);
+        }
+
+        struct bind_storages_f {
+            intermediate_expand &m_obj;
+            template <class... Args>
+            void operator()(Args const &... args) const {
+                m_obj.bind_storages(args...);
             }
+            using result_type = void;
+        };
+
+        void run_local_domains() {
+            for (auto &local_domains : m_local_domains)
+                m_intermediate.run_local_domains(local_domains);
+            m_intermediate_remainder.run();
+        }
+
+        template <class Fun>
+        void setup_chunk_runs(size_t chunk, _impl::expand_detail::loops_t &loops, Fun const &fun) {
+            if (chunk < m_local_domains.size())
+                m_intermediate.setup_local_domains_run(m_local_domains[chunk],
+                    _impl::expand_detail::push_loop(loops, [&] { setup_chunk_runs(chunk + 1, loops, fun); }));
+            else
+                m_intermediate_remainder.setup_runs(loops, [&] {
+                    fun([&loops] {
+                        for (auto const &loop : loops)
+                            loop();
+                    });
+                });
+        }
+
+      public:
+        template <class BoundArgStoragePairsRefs>
+        intermediate_expand(Grid const &grid, BoundArgStoragePairsRefs &&arg_storage_pairs)
+            // public constructor splits given ard_storage_pairs to expandable and plain ones and delegates to the
+            // private constructor.
+            : intermediate_expand(
+                  grid, split_args_tuple<_impl::expand_detail::is_expandable>(wstd::move(arg_storage_pairs))) {}
+
+        template <class... Args, class... DataStores>
+        void run(arg_storage_pair<Args, DataStores> const &... args) {
+            m_meter.start();
+            bind_storages(args...);
+            run_local_domains();
             m_meter.pause();
         }
 
+        /// Binds the given storages for `run_prepared`. The expanded local domains are cached like for `run`, so they
+        /// are built by the first prepared run only.
+        template <class... Args, class... DataStores>
+        void prepare(arg_storage_pair<Args, DataStores> const &... args) {
+            std::tuple<arg_storage_pair<Args, DataStores>...> prepared_args{args...};
+            m_bind_prepared_storages = [prepared_args](intermediate_expand &obj) {
+                tuple_util::apply(bind_storages_f{obj}, prepared_args);
+            };
+        }
+
+        void run_prepared() {
+            assert(m_bind_prepared_storages);
+            m_meter.start();
+            m_bind_prepared_storages(*this);
+            run_local_domains();
+            m_meter.pause();
+        }
+
+        /// Does the host side part of `run_prepared` and calls `fun` with a functor that runs the backend loops of all
+        /// the chunks, see `intermediate::setup_prepared_run`.
+        template <class Fun>
+        void setup_prepared_run(Fun &&fun) {
+            assert(m_bind_prepared_storages);
+            m_bind_prepared_storages(*this);
+            _impl::expand_detail::loops_t loops;
+            setup_chunk_runs(0, loops, fun);
+        }
+
+        /**
+         *  The traffic model of the last run (or of the storages bound by `prepare`), the sum of the models of the
+         *  chunks: the storages that are not expanded are accessed once per chunk.
+         */
+        traffic_model get_traffic_model() const {
+            traffic_model res = m_intermediate.get_traffic_model();
+            res *= m_local_domains.size();
+            m_intermediate_remainder.add_traffic_model(res);
+            return res;
+        }
+
         std::string print_meter() const { return m_meter.to_string(); }
 
         double get_time() const { return m_meter.total_time(); }
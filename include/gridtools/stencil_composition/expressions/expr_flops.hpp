@@ -0,0 +1,68 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <type_traits>
+
+#include "../../common/defs.hpp"
+#include "expr_base.hpp"
+#include "expr_plus.hpp"
+#include "expr_pow.hpp"
+
+namespace gridtools {
+    namespace expressions {
+
+        /** \addtogroup stencil-composition
+            @{
+            \addtogroup expressions
+            @{
+        */
+
+        /**
+           The number of floating point operations of the expressions of the given types: one per binary operation and
+           per negation, `I - 1` multiplications for `pow<I>`. Accessors and constants do not count.
+
+           \code
+           using flops = expr_flops<decltype(in(1, 0, 0) + in(-1, 0, 0) - 2 * in())>; // 3
+           \endcode
+
+           A functor that declares `using flops = ...;` contributes to the operation count of the traffic model of the
+           computations that use it (see `traffic_model`).
+        */
+        template <class... Exprs>
+        struct expr_flops;
+
+        template <>
+        struct expr_flops<> : std::integral_constant<int_t, 0> {};
+
+        template <class Expr, class... Exprs>
+        struct expr_flops<Expr, Exprs...>
+            : std::integral_constant<int_t, expr_flops<Expr>::value + expr_flops<Exprs...>::value> {};
+
+        template <class T>
+        struct expr_flops<T> : std::integral_constant<int_t, 0> {};
+
+        template <class Op, class Arg>
+        struct expr_flops<expr<Op, Arg>> : std::integral_constant<int_t, expr_flops<Arg>::value + 1> {};
+
+        template <class Arg>
+        struct expr_flops<expr<plus_f, Arg>> : expr_flops<Arg> {};
+
+        template <int I, class Arg>
+        struct expr_flops<expr<pow_f<I>, Arg>>
+            : std::integral_constant<int_t, expr_flops<Arg>::value + (I > 1 ? I - 1 : 0)> {};
+
+        template <class Op, class Lhs, class Rhs>
+        struct expr_flops<expr<Op, Lhs, Rhs>>
+            : std::integral_constant<int_t, expr_flops<Lhs>::value + expr_flops<Rhs>::value + 1> {};
+        /** @} */
+        /** @} */
+    } // namespace expressions
+} // namespace gridtools
@@ -20,6 +20,7 @@
 */
 
 #include "./expr_divide.hpp"
+#include "./expr_flops.hpp"
 #include "./expr_minus.hpp"
 #include "./expr_plus.hpp"
 #include "./expr_pow.hpp"
@@ -0,0 +1,152 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include "../common/defs.hpp"
+#include "../meta.hpp"
+#include "extract_placeholders.hpp"
+#include "intermediate.hpp"
+#include "intermediate_impl.hpp"
+#include "mss.hpp"
+
+namespace gridtools {
+    namespace fuse_computations_impl_ {
+        template <class Intermediate>
+        struct intermediate_traits {
+            GT_STATIC_ASSERT(sizeof(Intermediate) == 0,
+                "fuse_computations takes computations created by make_computation or make_positional_computation "
+                "without expandable parameters");
+        };
+
+        template <bool IsStateful, class Backend, class Grid, class BoundArgStoragePairs, class MssDescriptors>
+        struct intermediate_traits<intermediate<IsStateful, Backend, Grid, BoundArgStoragePairs, MssDescriptors>> {
+            static constexpr bool is_stateful = IsStateful;
+            using backend_t = Backend;
+            using grid_t = Grid;
+            using bound_arg_storage_pairs_t = BoundArgStoragePairs;
+            using mss_descriptors_t = MssDescriptors;
+            using placeholders_t = GT_META_CALL(extract_placeholders_from_msses, MssDescriptors);
+            using rw_placeholders_t = GT_META_CALL(_impl::all_rw_args, MssDescriptors);
+        };
+
+        GT_META_LAZY_NAMESPACE {
+            /**
+             *  The i-th multistages of the computations become one multistage that runs all their stages. The
+             *  caches of the multistages are kept, the ones that are declared in several of them only once.
+             */
+            template <class Mss, class... Msses>
+            struct fuse_msses {
+                GT_STATIC_ASSERT(
+                    (conjunction<std::is_same<typename Mss::execution_engine_t,
+                        typename Msses::execution_engine_t>...>::value),
+                    "the multistages fused by fuse_computations should have the same execution engine");
+                using type = mss_descriptor<typename Mss::execution_engine_t,
+                    GT_META_CALL(meta::concat, (typename Mss::esf_sequence_t, typename Msses::esf_sequence_t...)),
+                    GT_META_CALL(meta::dedup,
+                        (GT_META_CALL(
+                            meta::concat, (typename Mss::cache_sequence_t, typename Msses::cache_sequence_t...))))>;
+            };
+        }
+        GT_META_DELEGATE_TO_LAZY(fuse_msses, class... Msses, Msses...);
+
+        template <class Placeholder>
+        struct uses_placeholder {
+            template <class Placeholders>
+            GT_META_DEFINE_ALIAS(apply, meta::st_contains, (Placeholders, Placeholder));
+        };
+
+        // a placeholder written by a computation can not be read or written by any other one
+        template <class PlaceholderLists>
+        struct is_used_by_one_computation {
+            template <class Placeholder>
+            GT_META_DEFINE_ALIAS(apply,
+                bool_constant,
+                (meta::length<GT_META_CALL(
+                        meta::filter, (uses_placeholder<Placeholder>::template apply, PlaceholderLists))>::value ==
+                    1));
+        };
+
+        template <class... Traits>
+        struct fused_intermediate {
+            using first_t = GT_META_CALL(meta::first, meta::list<Traits...>);
+
+            GT_STATIC_ASSERT((conjunction<bool_constant<Traits::is_stateful == first_t::is_stateful>...,
+                                 std::is_same<typename Traits::backend_t, typename first_t::backend_t>...,
+                                 std::is_same<typename Traits::grid_t, typename first_t::grid_t>...>::value),
+                "fuse_computations takes computations on the same backend and grid type");
+            GT_STATIC_ASSERT((conjunction<bool_constant<meta::length<typename Traits::mss_descriptors_t>::value ==
+                                                        meta::length<typename first_t::mss_descriptors_t>::value>...>::
+                                     value),
+                "the computations fused by fuse_computations should have the same number of multistages");
+
+            using rw_placeholders_t = GT_META_CALL(
+                meta::dedup, (GT_META_CALL(meta::concat, (typename Traits::rw_placeholders_t...))));
+            using placeholder_lists_t = meta::list<typename Traits::placeholders_t...>;
+            GT_STATIC_ASSERT(
+                (meta::all_of<is_used_by_one_computation<placeholder_lists_t>::template apply,
+                    rw_placeholders_t>::value),
+                "fuse_computations takes independent computations: a placeholder (temporaries included) that is "
+                "written by one of them can not be used by another one");
+
+            using bound_arg_storage_pairs_t = GT_META_CALL(
+                meta::concat, (typename Traits::bound_arg_storage_pairs_t...));
+            using mss_descriptors_t = GT_META_CALL(
+                meta::transform, (fuse_msses, typename Traits::mss_descriptors_t...));
+
+            using type = intermediate<first_t::is_stateful,
+                typename first_t::backend_t,
+                typename first_t::grid_t,
+                bound_arg_storage_pairs_t,
+                mss_descriptors_t>;
+        };
+
+        template <class Grid>
+        bool same_grid(Grid const &lhs, Grid const &rhs) {
+            return lhs.i_low_bound() == rhs.i_low_bound() && lhs.i_high_bound() == rhs.i_high_bound() &&
+                   lhs.j_low_bound() == rhs.j_low_bound() && lhs.j_high_bound() == rhs.j_high_bound() &&
+                   lhs.k_min() == rhs.k_min() && lhs.k_max() == rhs.k_max();
+        }
+
+        template <class Grid, class... Grids>
+        bool same_grids(Grid const &grid, Grids const &... grids) {
+            for (bool same : {true, same_grid(grid, grids)...})
+                if (!same)
+                    return false;
+            return true;
+        }
+    } // namespace fuse_computations_impl_
+
+    /**
+     *  Fuses independent computations on the same grid and backend into one computation.
+     *
+     *  The i-th multistages of the computations are merged into a single multistage, so that the fused computation
+     *  sweeps the grid once per multistage and the backends that fuse the stages of a multistage (see `mss_fuse_esfs`)
+     *  run the stages of all the computations on a block while its data is in cache. The stages with the same extent
+     *  end up in the same compound stage.
+     *
+     *  The computations should be independent: no placeholder written by one of them is read or written by another,
+     *  this is checked at compile time. Read only placeholders can be shared, but they can be bound at construction
+     *  by one computation only. The computations should have the same number of multistages with matching execution
+     *  engines. The storages bound to the computations are bound to the fused one. The computations must have the same
+     *  grid, std::runtime_error is thrown otherwise.
+     */
+    template <class Comp, class... Comps>
+    typename fuse_computations_impl_::fused_intermediate<fuse_computations_impl_::intermediate_traits<Comp>,
+        fuse_computations_impl_::intermediate_traits<Comps>...>::type
+    fuse_computations(Comp const &comp, Comps const &... comps) {
+        if (!fuse_computations_impl_::same_grids(comp.grid(), comps.grid()...))
+            throw std::runtime_error("fuse_computations: the computations must have the same grid");
+        return {comp.grid(), std::tuple_cat(comp.bound_arg_storage_pairs(), comps.bound_arg_storage_pairs()...)};
+    }
+} // namespace gridtools
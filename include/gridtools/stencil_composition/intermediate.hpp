@@ -9,13 +9,16 @@
  */
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <tuple>
 #include <utility>
 
+#include "../common/permute_to.hpp"
 #include "../common/timer/timer_traits.hpp"
 #include "../common/tuple_util.hpp"
 #include "../meta.hpp"
+#include "boundary_stage.hpp"
 #include "compute_extents_metafunctions.hpp"
 #include "dim.hpp"
 #include "esf.hpp"
@@ -26,6 +29,7 @@
 #include "level.hpp"
 #include "local_domain.hpp"
 #include "mss_components_metafunctions.hpp"
+#include "traffic_model.hpp"
 
 /**
  * @file
@@ -76,7 +80,12 @@ namespace gridtools {
     /**
      *  @brief structure collecting helper metafunctions
      */
-    template <bool IsStateful, class Backend, class Grid, class BoundArgStoragePairs, class MssDescriptors>
+    template <bool IsStateful,
+        class Backend,
+        class Grid,
+        class BoundArgStoragePairs,
+        class MssDescriptors,
+        class BoundaryStages = std::tuple<>>
     class intermediate;
 
     template <bool IsStateful,
@@ -84,17 +93,24 @@ namespace gridtools {
         class Grid,
         class... BoundPlaceholders,
         class... BoundDataStores,
-        class... MssDescriptors>
+        class... MssDescriptors,
+        class... BoundaryStages>
     class intermediate<IsStateful,
         Backend,
         Grid,
         std::tuple<arg_storage_pair<BoundPlaceholders, BoundDataStores>...>,
-        std::tuple<MssDescriptors...>> {
+        std::tuple<MssDescriptors...>,
+        std::tuple<BoundaryStages...>> {
         GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
 
         GT_STATIC_ASSERT(conjunction<is_mss_descriptor<MssDescriptors>...>::value,
             "make_computation args should be mss descriptors");
 
+        GT_STATIC_ASSERT(conjunction<is_boundary_stage<BoundaryStages>...>::value, GT_INTERNAL_ERROR);
+
+        GT_STATIC_ASSERT((sizeof...(BoundaryStages) == 0 || !std::is_same<Backend, backend::cuda>::value),
+            "boundary stages are not supported by the cuda backend");
+
         using mss_descriptors_t = std::tuple<MssDescriptors...>;
 
         using performance_meter_t = typename timer_traits<Backend>::timer_type;
@@ -122,6 +138,15 @@ namespace gridtools {
         GT_STATIC_ASSERT(
             meta::is_set_fast<meta::list<BoundPlaceholders...>>::value, "bound placeholders should be all different");
 
+        using boundary_placeholders_t =
+            GT_META_CALL(meta::concat, (meta::list<>, typename BoundaryStages::placeholders_t...));
+
+        template <class Arg>
+        using is_non_tmp_placeholder = meta::st_contains<non_tmp_placeholders_t, Arg>;
+
+        GT_STATIC_ASSERT((meta::all_of<is_non_tmp_placeholder, boundary_placeholders_t>::value),
+            "some placeholders of the boundary stages are not used in mss descriptors");
+
         template <class Arg>
         using is_free = negation<meta::st_contains<meta::list<BoundPlaceholders...>, Arg>>;
 
@@ -129,6 +154,10 @@ namespace gridtools {
 
         using bound_arg_storage_pair_tuple_t = std::tuple<arg_storage_pair<BoundPlaceholders, BoundDataStores>...>;
 
+        using free_arg_storage_pairs_t = GT_META_CALL(meta::transform, (to_arg_storage_pair, free_placeholders_t));
+        using free_arg_storage_pair_tuple_t =
+            GT_META_CALL(meta::rename, (meta::ctor<std::tuple<>>::apply, free_arg_storage_pairs_t));
+
         using esfs_t = GT_META_CALL(
             meta::flatten, (GT_META_CALL(meta::transform, (_impl::get_esfs, mss_descriptors_t))));
 
@@ -137,8 +166,13 @@ namespace gridtools {
         // This information is needed to allocate temporaries, and to provide the extent information to the user.
         using extent_map_t = GT_META_CALL(get_extent_map, esfs_t);
 
+        GT_STATIC_ASSERT((GT_META_CALL(boundary_stages_have_zero_extents, (extent_map_t, BoundaryStages...))::value),
+            "the placeholders of the boundary stages must not be read with a non zero horizontal extent");
+
       private:
         using fuse_esfs_t = decltype(mss_fuse_esfs(std::declval<Backend>()));
+        using shares_enclosing_omp_team_t = decltype(shares_enclosing_omp_team(std::declval<Backend>()));
+        using runs_block_epilogues_t = decltype(runs_block_epilogues(std::declval<Backend>()));
         using mss_components_array_t = GT_META_CALL(build_mss_components_array,
             (fuse_esfs_t::value, mss_descriptors_t, extent_map_t, typename Grid::axis_type));
 
@@ -175,6 +209,16 @@ namespace gridtools {
         //
         local_domains_t m_local_domains;
 
+        /// tuple with storages that are bound by `prepare` and the local domains built for them
+        //
+        free_arg_storage_pair_tuple_t m_prepared_arg_storage_pair_tuple;
+        local_domains_t m_prepared_local_domains;
+        bool m_is_prepared = false;
+
+        /// boundary conditions applied by the backend after the stages, see `make_boundary_stage`
+        //
+        std::tuple<BoundaryStages...> m_boundary_stages;
+
         struct check_grid_against_extents_f {
             Grid const &m_grid;
 
@@ -206,6 +250,14 @@ namespace gridtools {
 #endif
         }
 
+        intermediate(Grid const &grid,
+            std::tuple<arg_storage_pair<BoundPlaceholders, BoundDataStores>...> arg_storage_pairs,
+            std::tuple<BoundaryStages...> boundary_stages,
+            bool timer_enabled = true)
+            : intermediate(grid, wstd::move(arg_storage_pairs), timer_enabled) {
+            m_boundary_stages = wstd::move(boundary_stages);
+        }
+
         // TODO(anstaf): introduce overload that takes a tuple of arg_storage_pair's. it will simplify a bit
         //               implementation of the `intermediate_expanded` and `computation` by getting rid of
         //               `boost::fusion::invoke`.
@@ -218,11 +270,153 @@ namespace gridtools {
                 meta::is_set_fast<meta::list<Args...>>::value, "free placeholders should be all different");
             if (m_meter)
                 m_meter->start();
-            fused_mss_loop<mss_components_array_t>(Backend{}, local_domains(srcs...), m_grid);
+            this->local_domains(srcs...);
+            run_local_domains(m_local_domains);
+            if (m_meter)
+                m_meter->pause();
+        }
+
+        /**
+         *  Binds the given storages to the free placeholders and builds the local domains once, so that `run_prepared`
+         *  can repeat the computation on them without any host side setup.
+         */
+        template <class... Args, class... DataStores>
+        enable_if_t<sizeof...(Args) == meta::length<free_placeholders_t>::value> prepare(
+            arg_storage_pair<Args, DataStores> const &... srcs) {
+            GT_STATIC_ASSERT((conjunction<meta::st_contains<free_placeholders_t, Args>...>::value),
+                "some placeholders are not used in mss descriptors");
+            GT_STATIC_ASSERT(
+                meta::is_set_fast<meta::list<Args...>>::value, "free placeholders should be all different");
+            m_prepared_arg_storage_pair_tuple = permute_to<free_arg_storage_pair_tuple_t>(std::make_tuple(srcs...));
+            m_prepared_local_domains = this->local_domains(srcs...);
+            m_is_prepared = true;
+        }
+
+        /**
+         *  Runs the computation on the storages bound by the last call of `prepare`.
+         */
+        void run_prepared() {
+            assert(m_is_prepared);
+            if (m_meter)
+                m_meter->start();
+            tuple_util::for_each(_impl::sync_data_store_f{}, m_prepared_arg_storage_pair_tuple);
+            run_local_domains(m_prepared_local_domains);
             if (m_meter)
                 m_meter->pause();
         }
 
+        /**
+         *  Does the host side part of `run_prepared` and calls `fun` with a functor without arguments that runs the
+         *  backend loops. The storages and the temporaries stay ready until `fun` returns.
+         *
+         *  The functor has to be called by all threads of a parallel region (see computation_sequence): the threads
+         *  share the work if the backend supports it, otherwise a single thread runs the loops. In both cases the
+         *  threads meet at a barrier at the end. The meter is not used.
+         */
+        template <class Fun>
+        void setup_prepared_run(Fun &&fun) {
+            assert(m_is_prepared);
+            tuple_util::for_each(_impl::sync_data_store_f{}, m_prepared_arg_storage_pair_tuple);
+            setup_local_domains_run(m_prepared_local_domains, wstd::forward<Fun>(fun));
+        }
+
+        /**
+         *  Like `setup_prepared_run`, for local domains previously obtained from `local_domains`. The storages they
+         *  point to should still be alive, the free ones have to be synced beforehand if needed.
+         */
+        template <class Fun>
+        void setup_local_domains_run(local_domains_t &local_domains, Fun &&fun) {
+            setup_local_domains_run(local_domains, m_grid, wstd::forward<Fun>(fun));
+        }
+
+        /**
+         *  Like the above, on `grid` instead of the grid given at construction. The compute domain of `grid` should
+         *  lie within the one of the grid given at construction (see `run_temporally_blocked`).
+         */
+        template <class Fun>
+        void setup_local_domains_run(local_domains_t &local_domains, Grid const &grid, Fun &&fun) {
+            setup_storages(local_domains,
+                [&] { fun(team_loop(local_domains, grid, shares_enclosing_omp_team_t{})); });
+        }
+
+      private:
+        template <class Fun>
+        void setup_storages(local_domains_t &local_domains, Fun const &fun) {
+            tuple_util::for_each(_impl::sync_data_store_f{}, m_bound_arg_storage_pair_tuple);
+            tmp_storage::run_with_tmp_storages(Backend{}, m_tmp_arg_storage_pair_tuple, local_domains, fun);
+        }
+
+        // the backend loops, to be called by all threads of a parallel region
+        std::function<void()> team_loop(local_domains_t const &local_domains, Grid const &grid, std::true_type) const {
+            return [this, &local_domains, &grid] {
+                run_loops(local_domains, grid, m_boundary_stages, _impl::enclosing_omp_team{});
+            };
+        }
+
+        std::function<void()> team_loop(local_domains_t const &local_domains, Grid const &grid, std::false_type) const {
+            return [this, &local_domains, &grid] {
+#pragma omp single
+                run_loops(local_domains, grid, m_boundary_stages);
+            };
+        }
+
+        // `team` is empty or `_impl::enclosing_omp_team`
+        template <class... Team>
+        void run_loops(local_domains_t const &local_domains,
+            Grid const &grid,
+            std::tuple<> const &,
+            Team const &... team) const {
+            fused_mss_loop<mss_components_array_t>(Backend{}, team..., local_domains, grid);
+        }
+
+        template <class... Stages, class... Team>
+        void run_loops(local_domains_t const &local_domains,
+            Grid const &grid,
+            std::tuple<Stages...> const &,
+            Team const &... team) const {
+            // the halos are the ones of the grid of the computation, `grid` may be a part of it
+            auto epilogue = make_boundary_epilogue(m_grid, m_boundary_stages, local_domains);
+            run_loops(local_domains, grid, epilogue, runs_block_epilogues_t{}, team...);
+        }
+
+        template <class Epilogue, class... Team>
+        void run_loops(local_domains_t const &local_domains,
+            Grid const &grid,
+            Epilogue const &epilogue,
+            std::true_type,
+            Team const &... team) const {
+            fused_mss_loop<mss_components_array_t>(Backend{}, team..., local_domains, grid, epilogue);
+        }
+
+        // only for backends that do not share the loops with a team
+        template <class Epilogue>
+        void run_loops(
+            local_domains_t const &local_domains, Grid const &grid, Epilogue const &epilogue, std::false_type) const {
+            fused_mss_loop<mss_components_array_t>(Backend{}, local_domains, grid);
+            epilogue(grid.i_low_bound(), grid.i_high_bound(), grid.j_low_bound(), grid.j_high_bound(), grid.k_min(),
+                grid.k_max());
+        }
+
+      public:
+        /**
+         *  Runs the computation on local domains previously obtained from `local_domains`.
+         */
+        void run_local_domains(local_domains_t &local_domains) { run_local_domains(local_domains, m_grid); }
+
+        /**
+         *  Runs the computation on local domains previously obtained from `local_domains`, on a part of the grid.
+         */
+        void run_local_domains(local_domains_t &local_domains, Grid const &grid) {
+            setup_storages(local_domains, [&] { run_loops(local_domains, grid, m_boundary_stages); });
+        }
+
+        Grid const &grid() const { return m_grid; }
+
+        /**
+         *  The storages bound at construction, see `fuse_computations`.
+         */
+        bound_arg_storage_pair_tuple_t const &bound_arg_storage_pairs() const { return m_bound_arg_storage_pair_tuple; }
+
         std::string print_meter() const {
             assert(m_meter);
             return m_meter->to_string();
@@ -243,6 +437,13 @@ namespace gridtools {
             m_meter->reset();
         }
 
+        /**
+         *  The minimum memory traffic and the operation count of a run, see `traffic_model`.
+         */
+        traffic_model get_traffic_model() const {
+            return make_traffic_model<esfs_t, extent_map_t, non_tmp_placeholders_t>(m_grid);
+        }
+
         template <class Placeholder,
             class RwArgs = GT_META_CALL(_impl::all_rw_args, mss_descriptors_t),
             intent Intent = meta::st_contains<RwArgs, Placeholder>::value ? intent::inout : intent::in>
@@ -9,6 +9,9 @@
  */
 #pragma once
 
+#include <cassert>
+#include <vector>
+
 #include "../common/functional.hpp"
 #include "../common/hymap.hpp"
 #include "../common/tuple_util.hpp"
@@ -48,6 +51,30 @@ namespace gridtools {
             tuple_util::for_each_in_cartesian_product(set_arg_store_pair_to_local_domain_f{}, srcs, local_domains);
         }
 
+        // makes the data stores of arg_storage_pairs that are already set to local domains ready to be used by the
+        // target again, the same way `sid_get_origin` does
+        struct sync_data_store_f {
+            template <class Storage, class StorageInfo>
+            void operator()(data_store<Storage, StorageInfo> const &src) const {
+                auto &&storage_ptr = src.get_storage_ptr();
+                assert(storage_ptr);
+                if (storage_ptr->device_needs_update_impl())
+                    storage_ptr->sync();
+                storage_ptr->reactivate_target_write_views();
+            }
+
+            template <class DataStore>
+            void operator()(std::vector<DataStore> const &src) const {
+                for (auto const &data_store : src)
+                    (*this)(data_store);
+            }
+
+            template <class Arg, class DataStore>
+            void operator()(arg_storage_pair<Arg, DataStore> const &src) const {
+                (*this)(src.m_value);
+            }
+        };
+
         template <class Mss>
         struct non_cached_tmp_f {
             using local_caches_t = GT_META_CALL(meta::filter, (is_local_cache, typename Mss::cache_sequence_t));
@@ -74,9 +101,20 @@ namespace gridtools {
             struct generator {
                 template <class Grid>
                 ArgStoragePair operator()(Grid const &grid) const {
+                    return make(GT_META_CALL(uses_tmp_storage_pool, Backend){}, grid);
+                }
+
+              private:
+                template <class Grid>
+                ArgStoragePair make(std::false_type, Grid const &grid) const {
                     return tmp_storage::make_tmp_data_store<MaxExtent>(
                         Backend{}, typename ArgStoragePair::arg_t{}, grid);
                 }
+                template <class Grid>
+                ArgStoragePair make(std::true_type, Grid const &grid) const {
+                    return tmp_storage::make_pooled_tmp_data_store<MaxExtent>(
+                        Backend{}, typename ArgStoragePair::arg_t{}, grid);
+                }
             };
 
             template <class T>
@@ -17,6 +17,7 @@
 #include "../meta/defs.hpp"
 #include "../meta/transform.hpp"
 #include "../meta/type_traits.hpp"
+#include "boundary_stage.hpp"
 #include "computation.hpp"
 #include "expandable_parameters/expand_factor.hpp"
 #include "expandable_parameters/intermediate_expand.hpp"
@@ -41,12 +42,18 @@ namespace gridtools {
                 class ArgsPair = decltype(
                     split_args<is_arg_storage_pair>(wstd::forward<Args>(std::declval<Args>())...)),
                 class ArgStoragePairs = GT_META_CALL(decay_elements, typename ArgsPair::first_type),
-                class Msses = GT_META_CALL(decay_elements, typename ArgsPair::second_type)>
-            intermediate<IsStateful, Backend, Grid, ArgStoragePairs, Msses> operator()(
+                class StagesPair = decltype(
+                    split_args_tuple<is_boundary_stage>(std::declval<typename ArgsPair::second_type>())),
+                class BoundaryStages = GT_META_CALL(decay_elements, typename StagesPair::first_type),
+                class Msses = GT_META_CALL(decay_elements, typename StagesPair::second_type)>
+            intermediate<IsStateful, Backend, Grid, ArgStoragePairs, Msses, BoundaryStages> operator()(
                 Grid const &grid, Args &&... args) const {
-                // split arg_storage_pair and mss descriptor arguments and forward it to intermediate constructor
+                // split arg_storage_pair, boundary stage and mss descriptor arguments and forward them to
+                // intermediate constructor
                 auto &&args_pair = split_args<is_arg_storage_pair>(wstd::forward<Args>(args)...);
-                return {grid, wstd::move(args_pair.first)};
+                return {grid,
+                    wstd::move(args_pair.first),
+                    split_args_tuple<is_boundary_stage>(wstd::move(args_pair.second)).first};
             }
         };
 
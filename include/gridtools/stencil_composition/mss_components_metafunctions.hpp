@@ -13,22 +13,50 @@
 
 #include "../common/defs.hpp"
 #include "../meta.hpp"
+#include "caches/cache_traits.hpp"
 #include "esf_metafunctions.hpp"
 #include "mss.hpp"
 #include "mss_components.hpp"
 
 namespace gridtools {
     namespace mss_comonents_metafunctions_impl_ {
+        template <class Arg>
+        struct esf_accesses_arg_f {
+            template <class Esf>
+            GT_META_DEFINE_ALIAS(apply, meta::st_contains, (typename Esf::args_t, Arg));
+        };
+
+        /**
+         * @brief filters the caches of an mss that is split into single ESFs
+         *
+         * A k cache only lives during the k loop of a single ESF, thus it is kept only if no other ESF of the
+         * original mss accesses the cached field. Otherwise values passed between ESFs would be lost and the field
+         * is accessed in memory instead. ij caches are kept unchanged.
+         */
+        template <class Esfs, class Esf>
+        struct keep_cache_for_esf_f {
+            template <class Cache, class Arg = typename Cache::arg_t>
+            struct apply
+                : bool_constant<!is_k_cache<Cache>::value ||
+                                (meta::st_contains<typename Esf::args_t, Arg>::value &&
+                                    meta::length<GT_META_CALL(meta::filter,
+                                        (esf_accesses_arg_f<Arg>::template apply, Esfs))>::value == 1)> {};
+        };
+
         GT_META_LAZY_NAMESPACE {
             template <class>
             struct mss_split_esfs;
             template <class ExecutionEngine, class EsfSequence, class CacheSequence>
             struct mss_split_esfs<mss_descriptor<ExecutionEngine, EsfSequence, CacheSequence>> {
                 GT_STATIC_ASSERT((meta::all_of<is_esf_descriptor, EsfSequence>::value), GT_INTERNAL_ERROR);
-                template <class Esf>
-                GT_META_DEFINE_ALIAS(
-                    make_mss, meta::id, (mss_descriptor<ExecutionEngine, std::tuple<Esf>, CacheSequence>));
                 using esfs_t = GT_META_CALL(unwrap_independent, EsfSequence);
+                template <class Esf>
+                GT_META_DEFINE_ALIAS(make_mss,
+                    meta::id,
+                    (mss_descriptor<ExecutionEngine,
+                        std::tuple<Esf>,
+                        GT_META_CALL(
+                            meta::filter, (keep_cache_for_esf_f<esfs_t, Esf>::template apply, CacheSequence))>));
                 using type = GT_META_CALL(meta::transform, (make_mss, esfs_t));
             };
         }
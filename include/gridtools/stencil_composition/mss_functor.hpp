@@ -70,4 +70,24 @@ namespace gridtools {
             mss_functor<MssComponentsArray, Backend, LocalDomains, Grid, ExecutionInfo>{
                 local_domains, grid, execution_info});
     }
+
+    namespace _impl {
+        /**
+         * @brief The block epilogue of the backends that do nothing after a block.
+         *
+         * A block epilogue is called by the mc and x86 backends after all mss functors of a block have run, with the
+         * bounds (included) of the compute domain of the block: `(i_first, i_last, j_first, j_last, k_first, k_last)`
+         * (see `make_boundary_epilogue`).
+         */
+        struct no_block_epilogue {
+            void operator()(int_t, int_t, int_t, int_t, int_t, int_t) const {}
+        };
+
+        /**
+         * @brief Tag of the backend loops that are called by all threads of an enclosing parallel region, which share
+         * the blocks instead of forking threads of their own and meet at a barrier at the end (see
+         * computation_sequence).
+         */
+        struct enclosing_omp_team {};
+    } // namespace _impl
 } // namespace gridtools
@@ -0,0 +1,329 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+#if defined(GT_ENABLE_STAGE_METERS) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define GT_STAGE_METERS_PERF_EVENTS
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../common/defs.hpp"
+
+#ifndef GT_ICOSAHEDRAL_GRIDS
+#include "./structured_grids/stage.hpp"
+#endif
+
+/** @file
+    Per stage meters of the mc and x86 backends, enabled by defining GT_ENABLE_STAGE_METERS (the
+    GT_ENABLE_STAGE_METERS CMake option for the tests).
+
+    The backends time the loops of every stage (a compound stage on mc, a single stage on x86) on every block and, on
+    Linux when perf events are accessible, count the cycles and the last level cache misses of the calling thread.
+    The results are accumulated per thread and per stage functor name. `stage_meters::instance().to_json()` exports
+    them, pyutils/perftest reads them with `result.load_stage_meters`.
+
+    The meters are meant for finding the expensive stages of a computation, they add the cost of reading the clock
+    and the counters to every block.
+*/
+
+namespace gridtools {
+    namespace stage_meters_impl_ {
+        template <class T>
+        std::string type_name() {
+            char const *name = typeid(T).name();
+#ifdef __GNUG__
+            int status;
+            std::unique_ptr<char, void (*)(void *)> demangled(
+                abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+            if (status == 0)
+                return demangled.get();
+#endif
+            return name;
+        }
+
+        template <class Stage>
+        struct stage_name {
+            static std::string get() { return type_name<Stage>(); }
+        };
+
+#ifndef GT_ICOSAHEDRAL_GRIDS
+        template <class Functor, class Extent, class Args>
+        struct stage_name<regular_stage<Functor, Extent, Args>> {
+            static std::string get() { return type_name<Functor>(); }
+        };
+
+        template <class Stage, class... Stages>
+        struct stage_name<compound_stage<Stage, Stages...>> {
+            static std::string get() {
+                std::string res = stage_name<Stage>::get();
+                (void)(int[]){((void)(res += "+" + stage_name<Stages>::get()), 0)...};
+                return res;
+            }
+        };
+#endif
+
+        /**
+           Cycles and last level cache misses of the calling thread, not available if perf events can not be opened
+           (e.g. because of /proc/sys/kernel/perf_event_paranoid).
+        */
+        class perf_counters {
+            int m_cycles = -1;
+            int m_llc_misses = -1;
+
+#ifdef GT_STAGE_METERS_PERF_EVENTS
+            static int open(unsigned long long config) {
+                perf_event_attr attr = {};
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(perf_event_attr);
+                attr.config = config;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+
+            static long long value(int fd) {
+                long long res;
+                return ::read(fd, &res, sizeof(res)) == sizeof(res) ? res : 0;
+            }
+#endif
+
+          public:
+            perf_counters() {
+#ifdef GT_STAGE_METERS_PERF_EVENTS
+                m_cycles = open(PERF_COUNT_HW_CPU_CYCLES);
+                m_llc_misses = open(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+            }
+            perf_counters(perf_counters const &) = delete;
+            perf_counters &operator=(perf_counters const &) = delete;
+            ~perf_counters() {
+#ifdef GT_STAGE_METERS_PERF_EVENTS
+                if (m_cycles >= 0)
+                    close(m_cycles);
+                if (m_llc_misses >= 0)
+                    close(m_llc_misses);
+#endif
+            }
+
+            bool available() const { return m_cycles >= 0 && m_llc_misses >= 0; }
+
+            void read(long long &cycles, long long &llc_misses) const {
+#ifdef GT_STAGE_METERS_PERF_EVENTS
+                if (available()) {
+                    cycles = value(m_cycles);
+                    llc_misses = value(m_llc_misses);
+                    return;
+                }
+#endif
+                cycles = 0;
+                llc_misses = 0;
+            }
+        };
+
+        struct record {
+            double time = 0;
+            std::size_t count = 0;
+            long long cycles = 0;
+            long long llc_misses = 0;
+
+            record &operator+=(record const &other) {
+                time += other.time;
+                count += other.count;
+                cycles += other.cycles;
+                llc_misses += other.llc_misses;
+                return *this;
+            }
+        };
+
+        struct thread_records {
+            int thread;
+            perf_counters counters;
+            // the stage names are static, they are identified by address
+            std::map<std::string const *, record> records;
+        };
+    } // namespace stage_meters_impl_
+
+    /**
+       The registry of the stage meters of all threads.
+    */
+    class stage_meters {
+        using thread_records = stage_meters_impl_::thread_records;
+
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<thread_records>> m_threads;
+
+        stage_meters() = default;
+
+        static void write_record(std::ostream &out, stage_meters_impl_::record const &rec, bool counters) {
+            out << "\"time\": " << rec.time << ", \"count\": " << rec.count;
+            if (counters)
+                out << ", \"cycles\": " << rec.cycles << ", \"llc_misses\": " << rec.llc_misses
+                    << ", \"llc_miss_bytes\": " << rec.llc_misses * 64;
+            else
+                out << ", \"cycles\": null, \"llc_misses\": null, \"llc_miss_bytes\": null";
+        }
+
+      public:
+        stage_meters(stage_meters const &) = delete;
+        stage_meters &operator=(stage_meters const &) = delete;
+
+        static stage_meters &instance() {
+            static stage_meters res;
+            return res;
+        }
+
+        /// The records of the calling thread, registered on the first call.
+        thread_records &local() {
+            thread_local thread_records *res = nullptr;
+            if (!res) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_threads.emplace_back(new thread_records());
+#ifdef _OPENMP
+                m_threads.back()->thread = omp_get_thread_num();
+#else
+                m_threads.back()->thread = 0;
+#endif
+                res = m_threads.back().get();
+            }
+            return *res;
+        }
+
+        /// Clears the records, should not be called while stages run.
+        void reset() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto &thread : m_threads)
+                thread->records.clear();
+        }
+
+        /// The total time [s] of the stage with the given name over all threads.
+        double total_time(std::string const &name) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            double res = 0;
+            for (auto const &thread : m_threads)
+                for (auto const &item : thread->records)
+                    if (*item.first == name)
+                        res += item.second.time;
+            return res;
+        }
+
+        /**
+           The records as JSON: a list of stages, each with its totals over the threads and the records of every
+           thread. The counters are null if they are not available. `llc_miss_bytes` estimates the bytes loaded from
+           memory as 64 bytes per last level cache miss.
+
+           \code
+           {"stages": [{"stage": "lap_function", "time": 0.12, "count": 40, "cycles": ..., "llc_misses": ...,
+                        "llc_miss_bytes": ..., "threads": [{"thread": 0, "time": 0.06, ...}, ...]}, ...]}
+           \endcode
+        */
+        std::string to_json() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            using namespace stage_meters_impl_;
+            std::map<std::string, std::map<int, std::pair<record, bool>>> stages;
+            for (auto const &thread : m_threads)
+                for (auto const &item : thread->records) {
+                    auto &rec = stages[*item.first][thread->thread];
+                    rec.first += item.second;
+                    rec.second = thread->counters.available();
+                }
+            std::ostringstream out;
+            out.precision(9);
+            out << "{\"stages\": [";
+            bool first_stage = true;
+            for (auto const &stage : stages) {
+                record total;
+                bool counters = true;
+                for (auto const &thread : stage.second) {
+                    total += thread.second.first;
+                    counters = counters && thread.second.second;
+                }
+                out << (first_stage ? "" : ", ") << "{\"stage\": \"" << stage.first << "\", ";
+                write_record(out, total, counters);
+                out << ", \"threads\": [";
+                bool first_thread = true;
+                for (auto const &thread : stage.second) {
+                    out << (first_thread ? "" : ", ") << "{\"thread\": " << thread.first << ", ";
+                    write_record(out, thread.second.first, thread.second.second);
+                    out << "}";
+                    first_thread = false;
+                }
+                out << "]}";
+                first_stage = false;
+            }
+            out << "]}";
+            return out.str();
+        }
+    };
+
+#ifdef GT_ENABLE_STAGE_METERS
+    /**
+       Adds the time and the counters between its construction and its destruction to the record of `Stage` of the
+       calling thread.
+    */
+    template <class Stage>
+    class scoped_stage_meter {
+        using clock_t = std::chrono::steady_clock;
+
+        static std::string const &name() {
+            static const std::string res = stage_meters_impl_::stage_name<Stage>::get();
+            return res;
+        }
+
+        stage_meters_impl_::thread_records &m_records;
+        clock_t::time_point m_start;
+        long long m_cycles;
+        long long m_llc_misses;
+
+      public:
+        scoped_stage_meter() : m_records(stage_meters::instance().local()) {
+            m_records.counters.read(m_cycles, m_llc_misses);
+            m_start = clock_t::now();
+        }
+        scoped_stage_meter(scoped_stage_meter const &) = delete;
+        scoped_stage_meter &operator=(scoped_stage_meter const &) = delete;
+
+        ~scoped_stage_meter() {
+            double time = std::chrono::duration<double>(clock_t::now() - m_start).count();
+            long long cycles, llc_misses;
+            m_records.counters.read(cycles, llc_misses);
+            auto &rec = m_records.records[&name()];
+            rec.time += time;
+            ++rec.count;
+            rec.cycles += cycles - m_cycles;
+            rec.llc_misses += llc_misses - m_llc_misses;
+        }
+    };
+#else
+    template <class Stage>
+    struct scoped_stage_meter {
+        scoped_stage_meter() {}
+    };
+#endif
+} // namespace gridtools
@@ -21,9 +21,12 @@
  */
 
 #include "accessor.hpp"
+#include "boundary_stage.hpp"
 #include "caches/define_caches.hpp"
 #include "computation.hpp"
+#include "computation_sequence.hpp"
 #include "esf.hpp"
+#include "fuse_computations.hpp"
 #include "global_parameter.hpp"
 #include "grid.hpp"
 #include "make_computation.hpp"
@@ -138,22 +138,6 @@ namespace gridtools {
             m_iterate_domain_cache.template flush_caches<IterationPolicy>(*this, last_level);
         }
 
-        template <class Arg, class DataStore = typename Arg::data_store_t, class Data = typename DataStore::data_t>
-        GT_FUNCTION Data *deref_for_k_cache(int_t k_offset) const {
-            using storage_info_t = typename DataStore::storage_info_t;
-            static constexpr auto storage_info_index =
-                meta::st_position<typename local_domain_t::strides_kinds_t, storage_info_t>::value;
-
-            auto offset = this->m_index[storage_info_index];
-            sid::shift(offset,
-                sid::get_stride<dim::k>(host_device::at_key<storage_info_t>(this->m_local_domain.m_strides_map)),
-                k_offset);
-
-            return offset < host_device::at_key<storage_info_t>(this->m_local_domain.m_total_length_map) && offset >= 0
-                       ? host_device::at_key<Arg>(this->m_ptr_map) + offset
-                       : nullptr;
-        }
-
         template <class Arg, class Accessor, enable_if_t<meta::st_contains<ij_cache_args_t, Arg>::value, int> = 0>
         GT_FUNCTION typename Arg::data_store_t::data_t &deref(Accessor const &acc) const {
             return boost::fusion::at_key<Arg>(*m_pshared_iterate_domain).at(m_thread_pos[0], m_thread_pos[1], acc);
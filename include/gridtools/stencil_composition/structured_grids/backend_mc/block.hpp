@@ -10,8 +10,8 @@
 #pragma once
 
 #include "../../../common/defs.hpp"
+#include "../../../common/execinfo_mc.hpp"
 #include "../../../common/host_device.hpp"
-#include "./execinfo_mc.hpp"
 
 namespace gridtools {
     template <class Grid>
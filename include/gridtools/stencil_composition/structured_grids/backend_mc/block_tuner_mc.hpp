@@ -0,0 +1,202 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "../../../common/defs.hpp"
+#include "../../../common/execinfo_mc.hpp"
+
+/**@file
+ * @brief Block size autotuning for the MC backend (enabled by defining GT_MC_AUTOTUNE).
+ *
+ * The first run of every stencil on a given grid size is an untimed warm-up with the default shape computed by
+ * execinfo_mc, the following runs are executed with different candidate block shapes, all smaller than or equal to the
+ * default shape (temporaries are allocated for the default shape). The fastest shape is then used for all following runs. If the environment variable GT_MC_TUNING_CACHE is
+ * set to a file path, tuned shapes are appended to that file and read back on startup, such that restarted
+ * applications skip the tuning phase.
+ */
+namespace gridtools {
+    namespace _impl_block_tuner_mc {
+        /**
+         * @brief Block shape along the i- and j-axis.
+         */
+        struct block_shape {
+            int_t i_block_size;
+            int_t j_block_size;
+        };
+
+        /**
+         * @brief 64bit FNV-1a hash, stable across compilers and runs (unlike std::hash).
+         */
+        inline std::uint64_t fnv1a(std::string const &str) {
+            std::uint64_t hash = 14695981039346656037ull;
+            for (char c : str) {
+                hash ^= (unsigned char)c;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        /**
+         * @brief In-memory and optional on-disk storage of tuned block shapes.
+         *
+         * The on-disk format is a text file with one entry per line: `<key> <i_block_size> <j_block_size>`. Later
+         * entries override earlier ones with the same key.
+         */
+        class tuning_cache {
+            std::string m_path;
+            std::map<std::string, block_shape> m_shapes;
+
+          public:
+            explicit tuning_cache(std::string path = {}) : m_path(std::move(path)) {
+                if (m_path.empty())
+                    return;
+                std::ifstream file(m_path);
+                std::string key;
+                block_shape shape;
+                while (file >> key >> shape.i_block_size >> shape.j_block_size)
+                    m_shapes[key] = shape;
+            }
+
+            bool lookup(std::string const &key, block_shape &shape) const {
+                auto it = m_shapes.find(key);
+                if (it == m_shapes.end())
+                    return false;
+                shape = it->second;
+                return true;
+            }
+
+            void store(std::string const &key, block_shape const &shape) {
+                m_shapes[key] = shape;
+                if (m_path.empty())
+                    return;
+                std::ostringstream line;
+                line << key << " " << shape.i_block_size << " " << shape.j_block_size << "\n";
+                std::ofstream(m_path, std::ios::app) << line.str();
+            }
+        };
+
+        inline tuning_cache &get_tuning_cache() {
+            static tuning_cache cache(std::getenv("GT_MC_TUNING_CACHE") ? std::getenv("GT_MC_TUNING_CACHE") : "");
+            return cache;
+        }
+    } // namespace _impl_block_tuner_mc
+
+    /**
+     * @brief Tuning state of a single stencil on a single grid size.
+     */
+    class block_tuner_mc {
+        using block_shape = _impl_block_tuner_mc::block_shape;
+
+        std::string m_key;
+        std::vector<block_shape> m_candidates;
+        std::size_t m_current = 0;
+        block_shape m_best;
+        double m_best_time = std::numeric_limits<double>::max();
+        bool m_warmed_up = false;
+        bool m_tuned = false;
+
+        static void add_candidate(std::vector<block_shape> &candidates, block_shape const &shape) {
+            for (auto const &c : candidates)
+                if (c.i_block_size == shape.i_block_size && c.j_block_size == shape.j_block_size)
+                    return;
+            candidates.push_back(shape);
+        }
+
+      public:
+        template <class Grid>
+        block_tuner_mc(std::string key, Grid const &grid) : m_key(std::move(key)) {
+            execinfo_mc default_exinfo(grid);
+            const int_t i_max = default_exinfo.i_block_size();
+            const int_t j_max = default_exinfo.j_block_size();
+            m_best = {i_max, j_max};
+
+            // the default shape comes first, it is also used for the warm-up run
+            for (int_t i_div = 1; i_div <= 4; i_div *= 2) {
+                const int_t i_size = (i_max + i_div - 1) / i_div;
+                if (i_div > 1 && i_size < 8)
+                    break;
+                for (int_t j_div = 1; j_div <= 8; j_div *= 2)
+                    add_candidate(m_candidates, {i_size, (j_max + j_div - 1) / j_div});
+            }
+
+            // entries not fitting the allocated temporaries are ignored
+            block_shape cached;
+            if (_impl_block_tuner_mc::get_tuning_cache().lookup(m_key, cached) && cached.i_block_size > 0 &&
+                cached.i_block_size <= i_max && cached.j_block_size > 0 && cached.j_block_size <= j_max) {
+                m_best = cached;
+                m_tuned = true;
+            }
+        }
+
+        /** @brief True if tuning has finished. */
+        bool tuned() const { return m_tuned; }
+
+        /** @brief Block shape to use for the next run. */
+        template <class Grid>
+        execinfo_mc execinfo(Grid const &grid) const {
+            block_shape const &shape = m_tuned ? m_best : m_candidates[m_current];
+            return {grid, shape.i_block_size, shape.j_block_size};
+        }
+
+        /**
+         * @brief Reports the measured run time of the shape returned by the last call to `execinfo()`.
+         *
+         * The time of the first run is ignored: caches are cold and memory pages are touched for the first time, which
+         * would bias the choice against the shape that is measured first.
+         */
+        void report(double time) {
+            assert(!m_tuned);
+            if (!m_warmed_up) {
+                m_warmed_up = true;
+                return;
+            }
+            if (time < m_best_time) {
+                m_best_time = time;
+                m_best = m_candidates[m_current];
+            }
+            if (++m_current == m_candidates.size()) {
+                m_tuned = true;
+                _impl_block_tuner_mc::get_tuning_cache().store(m_key, m_best);
+            }
+        }
+    };
+
+    /**
+     * @brief Returns the tuner for the given stencil type and grid.
+     *
+     * The key contains a hash of the type name (which includes the stencil and the data types of all fields), the
+     * grid size and the number of threads.
+     */
+    template <class Stencil, class Grid>
+    block_tuner_mc &get_block_tuner_mc(Grid const &grid) {
+        static std::map<std::string, block_tuner_mc> tuners;
+        std::ostringstream key;
+        key << std::hex << _impl_block_tuner_mc::fnv1a(typeid(Stencil).name()) << std::dec << "_"
+            << grid.i_high_bound() - grid.i_low_bound() + 1 << "x" << grid.j_high_bound() - grid.j_low_bound() + 1
+            << "x" << grid.k_total_length() << "_" << omp_get_max_threads();
+        auto it = tuners.find(key.str());
+        if (it == tuners.end())
+            it = tuners.emplace(key.str(), block_tuner_mc(key.str(), grid)).first;
+        return it->second;
+    }
+} // namespace gridtools
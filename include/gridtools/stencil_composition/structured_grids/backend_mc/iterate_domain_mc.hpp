@@ -101,31 +101,38 @@ namespace gridtools {
         GT_FORCE_INLINE void set_k_block_index(int_t k) { m_k_block_index = k; }
 
         /**
-         * @brief Returns the value pointed by an accessor.
+         * @brief Returns the pointer to the element referenced by an accessor.
          */
-        template <class Arg, class Accessor, enable_if_t<!meta::st_contains<IJCachedArgs, Arg>::value, int> = 0>
-        GT_FORCE_INLINE auto deref(Accessor const &accessor) const -> decltype(*at_key<Arg>(m_ptr_map)) {
+        template <class Arg, class Accessor>
+        GT_FORCE_INLINE auto ptr(Accessor const &accessor) const -> decay_t<decltype(at_key<Arg>(m_ptr_map))> {
             using sid_t = GT_META_CALL(storage_from_arg, (LocalDomain, Arg));
             using strides_kind_t = GT_META_CALL(sid::strides_kind, sid_t);
             auto const &strides = at_key<strides_kind_t>(m_strides_map);
             GT_META_CALL(sid::ptr_diff_type, sid_t) ptr_offset{};
             sid::shift(ptr_offset, sid::get_stride<dim::i>(strides), m_i_block_index);
             sid::shift(ptr_offset, sid::get_stride<dim::j>(strides), m_j_block_index);
-            sid::shift(ptr_offset, sid::get_stride<dim::k>(strides), m_k_block_index);
+            // ij-cached temporaries hold a single k-level per thread
+            if (!meta::st_contains<IJCachedArgs, Arg>::value)
+                sid::shift(ptr_offset, sid::get_stride<dim::k>(strides), m_k_block_index);
             sid::multi_shift(ptr_offset, strides, accessor);
-            return *(at_key<Arg>(m_ptr_map) + ptr_offset);
+            return at_key<Arg>(m_ptr_map) + ptr_offset;
         }
 
-        template <class Arg, class Accessor, enable_if_t<meta::st_contains<IJCachedArgs, Arg>::value, int> = 0>
+        /**
+         * @brief Returns the stride along the i-axis of the field bound to the given placeholder.
+         */
+        template <class Arg,
+            class Sid = GT_META_CALL(storage_from_arg, (LocalDomain, Arg)),
+            class StridesKind = GT_META_CALL(sid::strides_kind, Sid)>
+        GT_FORCE_INLINE auto i_stride() const
+            GT_AUTO_RETURN(sid::get_stride<dim::i>(at_key<StridesKind>(m_strides_map)));
+
+        /**
+         * @brief Returns the value pointed by an accessor.
+         */
+        template <class Arg, class Accessor>
         GT_FORCE_INLINE auto deref(Accessor const &accessor) const -> decltype(*at_key<Arg>(m_ptr_map)) {
-            using sid_t = GT_META_CALL(storage_from_arg, (LocalDomain, Arg));
-            using strides_kind_t = GT_META_CALL(sid::strides_kind, sid_t);
-            auto const &strides = at_key<strides_kind_t>(m_strides_map);
-            GT_META_CALL(sid::ptr_diff_type, sid_t) ptr_offset{};
-            sid::shift(ptr_offset, sid::get_stride<dim::i>(strides), m_i_block_index);
-            sid::shift(ptr_offset, sid::get_stride<dim::j>(strides), m_j_block_index);
-            sid::multi_shift(ptr_offset, strides, accessor);
-            return *(at_key<Arg>(m_ptr_map) + ptr_offset);
+            return *ptr<Arg>(accessor);
         }
 
         /** @brief Global i-index. */
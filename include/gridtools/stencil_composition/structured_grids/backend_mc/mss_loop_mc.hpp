@@ -9,20 +9,51 @@
  */
 #pragma once
 
+#include "../../../common/execinfo_mc.hpp"
 #include "../../../common/generic_metafunctions/for_each.hpp"
 #include "../../../meta.hpp"
 #include "../../caches/cache_metafunctions.hpp"
 #include "../../iteration_policy.hpp"
 #include "../../loop_interval.hpp"
 #include "../../run_functor_arguments.hpp"
-#include "execinfo_mc.hpp"
+#include "../../stage_meters.hpp"
 #include "iterate_domain_mc.hpp"
+#include "simd_mc.hpp"
 
 /**@file
  * @brief mss loop implementations for the mc backend
  */
 namespace gridtools {
     namespace _impl_mss_loop_mc {
+        /**
+         * @brief Executes the stage on all i-points in [i_first, i_last) of the current row.
+         */
+        template <class Stage, class ItDomain, enable_if_t<!is_simd_stage<Stage>::value, int> = 0>
+        GT_FORCE_INLINE void i_loop(ItDomain &it_domain, int_t i_first, int_t i_last) {
+#ifdef NDEBUG
+#pragma ivdep
+#pragma omp simd
+#endif
+            for (int_t i = i_first; i < i_last; ++i) {
+                it_domain.set_i_block_index(i);
+                Stage::exec(it_domain);
+            }
+        }
+
+        /**
+         * @brief Executes the stage on all i-points in [i_first, i_last) of the current row, GT_MC_SIMD_WIDTH points
+         * at once.
+         */
+        template <class Stage, class ItDomain, enable_if_t<is_simd_stage<Stage>::value, int> = 0>
+        GT_FORCE_INLINE void i_loop(ItDomain &it_domain, int_t i_first, int_t i_last) {
+            constexpr int_t width = GT_MC_SIMD_WIDTH;
+            for (int_t i = i_first; i < i_last; i += width) {
+                it_domain.set_i_block_index(i);
+                int_t lanes = i_last - i < width ? i_last - i : width;
+                Stage::exec(iterate_domain_simd_mc<ItDomain, width>(it_domain, lanes));
+            }
+        }
+
         /**
          * @brief Class for inner (block-level) looping.
          * Specialization for stencils with serial execution along k-axis and non-zero max extent.
@@ -44,6 +75,7 @@ namespace gridtools {
             GT_FORCE_INLINE void operator()(Stage) const {
                 using iteration_policy_t = iteration_policy<From, To, ExecutionType>;
                 using extent_t = typename Stage::extent_t;
+                scoped_stage_meter<Stage> meter;
 
                 const int_t i_first = extent_t::iminus::value;
                 const int_t i_last = m_execution_info.i_block_size + extent_t::iplus::value;
@@ -57,14 +89,7 @@ namespace gridtools {
                     for (int_t k = k_first; iteration_policy_t::condition(k, k_last);
                          iteration_policy_t::increment(k)) {
                         m_it_domain.set_k_block_index(k);
-#ifdef NDEBUG
-#pragma ivdep
-#pragma omp simd
-#endif
-                        for (int_t i = i_first; i < i_last; ++i) {
-                            m_it_domain.set_i_block_index(i);
-                            Stage::exec(m_it_domain);
-                        }
+                        i_loop<Stage>(m_it_domain, i_first, i_last);
                     }
                 }
             }
@@ -91,6 +116,7 @@ namespace gridtools {
             template <typename Stage>
             GT_FORCE_INLINE void operator()(Stage) const {
                 using extent_t = typename Stage::extent_t;
+                scoped_stage_meter<Stage> meter;
 
                 const int_t i_first = extent_t::iminus::value;
                 const int_t i_last = m_execution_info.i_block_size + extent_t::iplus::value;
@@ -99,14 +125,7 @@ namespace gridtools {
 
                 for (int_t j = j_first; j < j_last; ++j) {
                     m_it_domain.set_j_block_index(j);
-#ifdef NDEBUG
-#pragma ivdep
-#pragma omp simd
-#endif
-                    for (int_t i = i_first; i < i_last; ++i) {
-                        m_it_domain.set_i_block_index(i);
-                        Stage::exec(m_it_domain);
-                    }
+                    i_loop<Stage>(m_it_domain, i_first, i_last);
                 }
             }
         };
@@ -0,0 +1,290 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "../../../common/defs.hpp"
+#include "../../../meta.hpp"
+#include "../../accessor_intent.hpp"
+#include "../../iterate_domain_fwd.hpp"
+#include "../stage.hpp"
+
+/**@file
+ * @brief Explicit vector-lane execution of stages on the mc backend.
+ *
+ * Elementary functors can opt into vector-lane execution by declaring a nested type `simd` that evaluates to
+ * `std::true_type`:
+ *
+ *     struct lap {
+ *         using out = inout_accessor<0>;
+ *         using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+ *         using param_list = make_param_list<out, in>;
+ *         using simd = std::true_type;
+ *         ...
+ *     };
+ *
+ * The mc backend then executes the functor on GT_MC_SIMD_WIDTH consecutive i-points at once: reading an accessor
+ * returns a `simd_pack` holding the values of all lanes, writing to an accessor stores all lanes. At the end of a
+ * row only the remaining lanes are stored (masked scalar tail). The body of such a functor is restricted to
+ * arithmetic expressions (+, -, *, /) of accessors and scalars, so all other backends execute it unchanged.
+ * Positional stencils (using `eval.i()`) must not opt in.
+ */
+
+#ifndef GT_MC_SIMD_WIDTH
+#define GT_MC_SIMD_WIDTH 8
+#endif
+
+namespace gridtools {
+    /**
+     * @brief Values of a single field on all vector lanes.
+     */
+    template <class T, int_t Width>
+    struct simd_pack {
+        T m_values[Width];
+
+        GT_FORCE_INLINE T &operator[](int_t lane) { return m_values[lane]; }
+        GT_FORCE_INLINE T const &operator[](int_t lane) const { return m_values[lane]; }
+    };
+
+    /**
+     * @brief Reference to the elements of a field on all active vector lanes.
+     *
+     * Inactive lanes (at the end of a row) are never accessed in memory: loads replicate the value of the last active
+     * lane, stores skip them.
+     */
+    template <class T, int_t Width, class Stride>
+    class simd_ref {
+        T *m_ptr;
+        Stride m_stride;
+        int_t m_lanes;
+
+      public:
+        GT_FORCE_INLINE simd_ref(T *ptr, Stride stride, int_t lanes) : m_ptr(ptr), m_stride(stride), m_lanes(lanes) {}
+        simd_ref(simd_ref const &) = default;
+
+        GT_FORCE_INLINE simd_pack<T, Width> load() const {
+            simd_pack<T, Width> res;
+            if (m_lanes == Width && m_stride == 1) {
+                for (int_t lane = 0; lane < Width; ++lane)
+                    res[lane] = m_ptr[lane];
+            } else {
+                for (int_t lane = 0; lane < Width; ++lane)
+                    res[lane] = m_ptr[std::min(lane, m_lanes - 1) * m_stride];
+            }
+            return res;
+        }
+
+        GT_FORCE_INLINE void store(simd_pack<T, Width> const &values) const {
+            if (m_lanes == Width && m_stride == 1) {
+                for (int_t lane = 0; lane < Width; ++lane)
+                    m_ptr[lane] = values[lane];
+            } else {
+                for (int_t lane = 0; lane < m_lanes; ++lane)
+                    m_ptr[lane * m_stride] = values[lane];
+            }
+        }
+
+        // assignments store to the referenced elements, they never rebind the reference
+        GT_FORCE_INLINE simd_ref &operator=(simd_ref const &rhs) {
+            store(rhs.load());
+            return *this;
+        }
+        template <class Rhs>
+        GT_FORCE_INLINE simd_ref &operator=(Rhs const &rhs);
+        template <class Rhs>
+        GT_FORCE_INLINE simd_ref &operator+=(Rhs const &rhs);
+        template <class Rhs>
+        GT_FORCE_INLINE simd_ref &operator-=(Rhs const &rhs);
+        template <class Rhs>
+        GT_FORCE_INLINE simd_ref &operator*=(Rhs const &rhs);
+        template <class Rhs>
+        GT_FORCE_INLINE simd_ref &operator/=(Rhs const &rhs);
+    };
+
+    namespace _impl_simd_mc {
+        template <class T>
+        struct simd_width : std::integral_constant<int_t, 0> {};
+        template <class T, int_t Width>
+        struct simd_width<simd_pack<T, Width>> : std::integral_constant<int_t, Width> {};
+        template <class T, int_t Width, class Stride>
+        struct simd_width<simd_ref<T, Width, Stride>> : std::integral_constant<int_t, Width> {};
+
+        template <class T>
+        using is_simd = bool_constant<simd_width<T>::value != 0>;
+
+        template <class T>
+        GT_FORCE_INLINE T const &value(T const &obj) {
+            return obj;
+        }
+        template <class T, int_t Width, class Stride>
+        GT_FORCE_INLINE simd_pack<T, Width> value(simd_ref<T, Width, Stride> const &obj) {
+            return obj.load();
+        }
+
+        template <class T>
+        GT_FORCE_INLINE T const &lane(T const &obj, int_t) {
+            return obj;
+        }
+        template <class T, int_t Width>
+        GT_FORCE_INLINE T const &lane(simd_pack<T, Width> const &obj, int_t i) {
+            return obj[i];
+        }
+
+        template <class Lhs, class Rhs>
+        using width = std::integral_constant<int_t,
+            (simd_width<Lhs>::value > simd_width<Rhs>::value ? simd_width<Lhs>::value : simd_width<Rhs>::value)>;
+
+        template <class T, class Rhs, int_t Width>
+        GT_FORCE_INLINE simd_pack<T, Width> convert(Rhs const &rhs) {
+            auto const &rhs_value = value(rhs);
+            simd_pack<T, Width> res;
+            for (int_t i = 0; i < Width; ++i)
+                res[i] = lane(rhs_value, i);
+            return res;
+        }
+    } // namespace _impl_simd_mc
+
+#define GT_MC_SIMD_BINARY_OPERATOR(op)                                                                              \
+    template <class Lhs,                                                                                            \
+        class Rhs,                                                                                                  \
+        enable_if_t<_impl_simd_mc::is_simd<Lhs>::value || _impl_simd_mc::is_simd<Rhs>::value, int> = 0,             \
+        int_t Width = _impl_simd_mc::width<Lhs, Rhs>::value,                                                        \
+        class L = decltype(_impl_simd_mc::lane(_impl_simd_mc::value(std::declval<Lhs const &>()), 0)),              \
+        class R = decltype(_impl_simd_mc::lane(_impl_simd_mc::value(std::declval<Rhs const &>()), 0)),              \
+        class T = decay_t<decltype(std::declval<L>() op std::declval<R>())>>                                        \
+    GT_FORCE_INLINE simd_pack<T, Width> operator op(Lhs const &lhs, Rhs const &rhs) {                               \
+        auto const &lhs_value = _impl_simd_mc::value(lhs);                                                          \
+        auto const &rhs_value = _impl_simd_mc::value(rhs);                                                          \
+        simd_pack<T, Width> res;                                                                                    \
+        for (int_t i = 0; i < Width; ++i)                                                                           \
+            res[i] = _impl_simd_mc::lane(lhs_value, i) op _impl_simd_mc::lane(rhs_value, i);                        \
+        return res;                                                                                                 \
+    }                                                                                                               \
+    static_assert(1, "")
+
+    GT_MC_SIMD_BINARY_OPERATOR(+);
+    GT_MC_SIMD_BINARY_OPERATOR(-);
+    GT_MC_SIMD_BINARY_OPERATOR(*);
+    GT_MC_SIMD_BINARY_OPERATOR(/);
+
+#undef GT_MC_SIMD_BINARY_OPERATOR
+
+    template <class Arg, enable_if_t<_impl_simd_mc::is_simd<Arg>::value, int> = 0>
+    GT_FORCE_INLINE auto operator+(Arg const &arg) GT_AUTO_RETURN(_impl_simd_mc::value(arg));
+
+    template <class Arg,
+        enable_if_t<_impl_simd_mc::is_simd<Arg>::value, int> = 0,
+        class T = decay_t<decltype(_impl_simd_mc::value(std::declval<Arg const &>())[0])>>
+    GT_FORCE_INLINE simd_pack<T, _impl_simd_mc::simd_width<Arg>::value> operator-(Arg const &arg) {
+        auto const &arg_value = _impl_simd_mc::value(arg);
+        simd_pack<T, _impl_simd_mc::simd_width<Arg>::value> res;
+        for (int_t i = 0; i < _impl_simd_mc::simd_width<Arg>::value; ++i)
+            res[i] = -arg_value[i];
+        return res;
+    }
+
+    template <class T, int_t Width, class Stride>
+    template <class Rhs>
+    GT_FORCE_INLINE simd_ref<T, Width, Stride> &simd_ref<T, Width, Stride>::operator=(Rhs const &rhs) {
+        store(_impl_simd_mc::convert<T, Rhs, Width>(rhs));
+        return *this;
+    }
+    template <class T, int_t Width, class Stride>
+    template <class Rhs>
+    GT_FORCE_INLINE simd_ref<T, Width, Stride> &simd_ref<T, Width, Stride>::operator+=(Rhs const &rhs) {
+        return *this = *this + rhs;
+    }
+    template <class T, int_t Width, class Stride>
+    template <class Rhs>
+    GT_FORCE_INLINE simd_ref<T, Width, Stride> &simd_ref<T, Width, Stride>::operator-=(Rhs const &rhs) {
+        return *this = *this - rhs;
+    }
+    template <class T, int_t Width, class Stride>
+    template <class Rhs>
+    GT_FORCE_INLINE simd_ref<T, Width, Stride> &simd_ref<T, Width, Stride>::operator*=(Rhs const &rhs) {
+        return *this = *this * rhs;
+    }
+    template <class T, int_t Width, class Stride>
+    template <class Rhs>
+    GT_FORCE_INLINE simd_ref<T, Width, Stride> &simd_ref<T, Width, Stride>::operator/=(Rhs const &rhs) {
+        return *this = *this / rhs;
+    }
+
+    // packs and references are returned by value from the evaluator
+    template <class T, int_t Width>
+    struct apply_intent_type<intent::in, simd_pack<T, Width> &&> {
+        using type = simd_pack<T, Width>;
+    };
+
+    template <class T, int_t Width, class Stride>
+    struct apply_intent_type<intent::inout, simd_ref<T, Width, Stride> &&> {
+        using type = simd_ref<T, Width, Stride>;
+    };
+
+    /**
+     * @brief True if the elementary functor opted into vector-lane execution.
+     */
+    template <class Functor, class = void>
+    struct is_simd_functor : std::false_type {};
+
+    template <class Functor>
+    struct is_simd_functor<Functor, void_t<typename Functor::simd>> : bool_constant<Functor::simd::value> {};
+
+    /**
+     * @brief True if all elementary functors of the stage opted into vector-lane execution.
+     */
+    template <class Stage>
+    struct is_simd_stage : std::false_type {};
+
+    template <class Functor, class Extent, class Args>
+    struct is_simd_stage<regular_stage<Functor, Extent, Args>> : is_simd_functor<Functor> {};
+
+    template <class... Stages>
+    struct is_simd_stage<compound_stage<Stages...>> : conjunction<is_simd_stage<Stages>...> {};
+
+    /**
+     * @brief Iterate domain evaluating a stage on `Width` consecutive i-points, starting at the current position of
+     * the wrapped mc iterate domain.
+     */
+    template <class ItDomain, int_t Width>
+    class iterate_domain_simd_mc {
+        ItDomain const &m_it_domain;
+        int_t m_lanes;
+
+        template <class Arg, class Accessor>
+        GT_FORCE_INLINE auto make_ref(Accessor const &accessor) const GT_AUTO_RETURN((
+            simd_ref<remove_reference_t<decltype(*m_it_domain.template ptr<Arg>(accessor))>,
+                Width,
+                decltype(m_it_domain.template i_stride<Arg>())>{
+                m_it_domain.template ptr<Arg>(accessor), m_it_domain.template i_stride<Arg>(), m_lanes}));
+
+      public:
+        GT_FORCE_INLINE iterate_domain_simd_mc(ItDomain const &it_domain, int_t lanes)
+            : m_it_domain(it_domain), m_lanes(lanes) {}
+
+        template <class Arg, class Accessor, enable_if_t<Accessor::intent_v == intent::in, int> = 0>
+        GT_FORCE_INLINE auto deref(Accessor const &accessor) const
+            GT_AUTO_RETURN(make_ref<Arg>(accessor).load());
+
+        template <class Arg, class Accessor, enable_if_t<Accessor::intent_v == intent::inout, int> = 0>
+        GT_FORCE_INLINE auto deref(Accessor const &accessor) const GT_AUTO_RETURN(make_ref<Arg>(accessor));
+
+        /** @brief Global i-index of the first lane. */
+        GT_FORCE_INLINE int_t i() const { return m_it_domain.i(); }
+        GT_FORCE_INLINE int_t j() const { return m_it_domain.j(); }
+        GT_FORCE_INLINE int_t k() const { return m_it_domain.k(); }
+    };
+
+    template <class ItDomain, int_t Width>
+    struct is_iterate_domain<iterate_domain_simd_mc<ItDomain, Width>> : std::true_type {};
+} // namespace gridtools
@@ -10,7 +10,9 @@
 #pragma once
 
 #include "../../../common/defs.hpp"
+#include "../../../common/generic_metafunctions/utility.hpp"
 #include "../../../common/host_device.hpp"
+#include "tmp_storage_pool_mc.hpp"
 
 namespace gridtools {
     namespace tmp_storage {
@@ -36,5 +38,15 @@ namespace gridtools {
         GT_FUNCTION int_t get_j_block_offset(backend::mc const &, uint_t /*block_size*/, uint_t /*block_no*/) {
             return false ? 0 : throw "should not be used";
         }
+
+#ifdef GT_MC_TMP_POOL
+        constexpr std::true_type uses_tmp_storage_pool(backend::mc const &) { return {}; }
+
+        template <class TmpArgStoragePairs, class LocalDomains, class Fun>
+        void run_with_tmp_storages(
+            backend::mc const &, TmpArgStoragePairs const &tmps, LocalDomains &local_domains, Fun &&fun) {
+            run_with_tmp_storage_pool_mc(tmps, local_domains, wstd::forward<Fun>(fun));
+        }
+#endif
     } // namespace tmp_storage
 } // namespace gridtools
@@ -0,0 +1,240 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "../../../common/defs.hpp"
+#include "../../../common/hugepage_alloc.hpp"
+#include "../../../common/hymap.hpp"
+#include "../../../common/tuple_util.hpp"
+#include "../../../meta.hpp"
+#include "../../arg.hpp"
+
+/**@file
+ * @brief Process-wide pool for the temporaries of the mc backend.
+ *
+ * Computations run one after another, never concurrently, and the content of temporaries does not outlive a run. The
+ * temporaries of all computations can thus share the same memory: on each run, a computation borrows a single block
+ * from the pool that is large enough for all of its temporaries, and returns it at the end of the run.
+ *
+ * The setups of the runs can be nested, as in computation_sequence and in the chunks of expandable parameters, so the
+ * pool is a stack allocator: nested blocks are carved from the memory after the blocks already borrowed and must be
+ * returned in the reverse order. If a nested block does not fit, it is allocated separately and freed when returned;
+ * the next time the pool is empty, the memory is replaced by a single block of the largest total size ever borrowed
+ * at once. The pool thus only holds the memory of the largest nesting of temporaries, instead of the sum of the
+ * temporaries of all computations.
+ *
+ * The pool is used if GT_MC_TMP_POOL is defined.
+ */
+
+namespace gridtools {
+    class tmp_storage_pool_mc {
+        using holder_t = std::unique_ptr<void, std::integral_constant<decltype(&hugepage_free), &hugepage_free>>;
+
+        struct chunk {
+            holder_t m_holder;
+            std::size_t m_size;
+        };
+
+        // state of the pool before a block was borrowed
+        struct frame {
+            std::size_t m_current;
+            std::size_t m_top;
+            bool m_own_chunk; // the block was allocated separately
+        };
+
+        // nested blocks start at page boundaries, like the allocations of hugepage_alloc
+        static constexpr std::size_t alignment = 4096;
+
+        std::vector<chunk> m_chunks;
+        std::vector<frame> m_frames;
+        std::size_t m_top = 0;     // used bytes of the last chunk
+        std::size_t m_current = 0; // borrowed bytes, as if all blocks were carved from a single chunk
+        std::size_t m_peak = 0;
+
+        tmp_storage_pool_mc() = default;
+
+        static std::size_t align(std::size_t size) { return (size + alignment - 1) / alignment * alignment; }
+
+        void add_chunk(std::size_t size) {
+            m_chunks.push_back({holder_t(hugepage_alloc(size)), size});
+            m_top = 0;
+        }
+
+      public:
+        tmp_storage_pool_mc(tmp_storage_pool_mc const &) = delete;
+        tmp_storage_pool_mc &operator=(tmp_storage_pool_mc const &) = delete;
+
+        static tmp_storage_pool_mc &get() {
+            static tmp_storage_pool_mc s_pool;
+            return s_pool;
+        }
+
+        /**
+         * @brief Borrows a block of `size` bytes. Blocks must be returned in the reverse order of borrowing.
+         */
+        void *acquire(std::size_t size) {
+            frame previous = {m_current, m_top, false};
+            std::size_t offset = align(m_top);
+            if (m_frames.empty()) {
+                std::size_t needed = size > m_peak ? size : m_peak;
+                if (m_chunks.size() != 1 || m_chunks.front().m_size < needed) {
+                    // free the old memory first, so both are never resident at the same time
+                    m_chunks.clear();
+                    add_chunk(needed);
+                }
+                offset = 0;
+            } else if (offset + size > m_chunks.back().m_size) {
+                add_chunk(size);
+                previous.m_own_chunk = true;
+                offset = 0;
+            }
+            m_frames.push_back(previous);
+            m_top = offset + size;
+            m_current = m_frames.size() == 1 ? size : align(m_current) + size;
+            if (m_current > m_peak)
+                m_peak = m_current;
+            return static_cast<char *>(m_chunks.back().m_holder.get()) + offset;
+        }
+
+        /**
+         * @brief Returns the last borrowed block.
+         */
+        void release() {
+            assert(!m_frames.empty());
+            frame const &previous = m_frames.back();
+            if (previous.m_own_chunk)
+                m_chunks.pop_back();
+            m_current = previous.m_current;
+            m_top = previous.m_top;
+            m_frames.pop_back();
+        }
+
+        /**
+         * @brief Frees the memory held by the pool. No block must be borrowed.
+         */
+        void shrink() {
+            assert(m_frames.empty());
+            m_chunks.clear();
+            m_top = 0;
+        }
+
+        /** @brief Number of bytes currently borrowed. */
+        std::size_t current_usage() const { return m_current; }
+        /** @brief Maximum number of bytes ever borrowed at once. */
+        std::size_t peak_usage() const { return m_peak; }
+        /** @brief Number of bytes currently allocated by the pool. */
+        std::size_t reserved() const {
+            std::size_t res = 0;
+            for (auto const &c : m_chunks)
+                res += c.m_size;
+            return res;
+        }
+    };
+
+    namespace _impl_tmp_storage_pool_mc {
+        constexpr std::size_t page_size = 4096;
+
+        /**
+         * @brief Offset of the n-th temporary from the start of its page. Like hugepage_alloc, successive temporaries
+         * are shifted by some cache lines to reduce the risk of L1 cache set conflicts.
+         */
+        inline std::size_t page_offset(std::size_t n) { return std::size_t(64) << (n % 6); }
+
+        template <class DataStore>
+        std::size_t byte_size(DataStore const &data_store) {
+            using data_t = typename DataStore::data_t;
+            constexpr std::size_t align = DataStore::storage_info_t::alignment_t::value;
+            return (data_store.info().padded_total_length() + align) * sizeof(data_t);
+        }
+
+        struct size_f {
+            std::size_t &m_size;
+            std::size_t &m_n;
+
+            template <class Arg, class DataStore>
+            void operator()(arg_storage_pair<Arg, DataStore> const &src) const {
+                if (!src.m_value.get_storage_info_ptr())
+                    return;
+                std::size_t size = page_offset(m_n++) + byte_size(src.m_value);
+                m_size += (size + page_size - 1) / page_size * page_size;
+            }
+        };
+
+        template <class Arg, class Ptr>
+        struct set_ptr_f {
+            Ptr m_ptr;
+
+            template <class LocalDomain>
+            enable_if_t<meta::st_contains<typename LocalDomain::esf_args_t, Arg>::value> operator()(
+                LocalDomain &local_domain) const {
+                at_key<Arg>(local_domain.m_ptr_holder_map) = {m_ptr};
+            }
+            template <class LocalDomain>
+            enable_if_t<!meta::st_contains<typename LocalDomain::esf_args_t, Arg>::value> operator()(
+                LocalDomain &) const {}
+        };
+
+        template <class LocalDomains>
+        struct bind_f {
+            char *&m_cursor;
+            std::size_t &m_n;
+            LocalDomains &m_local_domains;
+
+            template <class Arg, class DataStore>
+            void operator()(arg_storage_pair<Arg, DataStore> const &src) const {
+                if (!src.m_value.get_storage_info_ptr())
+                    return;
+                using data_t = typename DataStore::data_t;
+                auto const &info = src.m_value.info();
+                char *begin = m_cursor + page_offset(m_n++);
+                std::size_t size = begin - m_cursor + byte_size(src.m_value);
+                m_cursor += (size + page_size - 1) / page_size * page_size;
+
+                // same alignment of the first element of the inner region as in mc_storage
+                constexpr std::uintptr_t byte_alignment =
+                    DataStore::storage_info_t::alignment_t::value * sizeof(data_t);
+                std::uintptr_t byte_offset = info.first_index_of_inner_region() * sizeof(data_t);
+                std::uintptr_t address_to_align = reinterpret_cast<std::uintptr_t>(begin) + byte_offset;
+                auto ptr = reinterpret_cast<data_t *>(
+                    (address_to_align + byte_alignment - 1) / byte_alignment * byte_alignment - byte_offset);
+                tuple_util::for_each(set_ptr_f<Arg, data_t *>{ptr}, m_local_domains);
+            }
+        };
+
+        struct release_guard {
+            ~release_guard() { tmp_storage_pool_mc::get().release(); }
+        };
+    } // namespace _impl_tmp_storage_pool_mc
+
+    /**
+     * @brief Binds the temporaries to memory borrowed from the pool and runs `fun`.
+     */
+    template <class TmpArgStoragePairs, class LocalDomains, class Fun>
+    void run_with_tmp_storage_pool_mc(TmpArgStoragePairs const &tmps, LocalDomains &local_domains, Fun &&fun) {
+        std::size_t size = 0;
+        std::size_t n = 0;
+        tuple_util::for_each(_impl_tmp_storage_pool_mc::size_f{size, n}, tmps);
+        if (size == 0) {
+            fun();
+            return;
+        }
+        char *cursor = static_cast<char *>(tmp_storage_pool_mc::get().acquire(size));
+        _impl_tmp_storage_pool_mc::release_guard guard;
+        n = 0;
+        tuple_util::for_each(_impl_tmp_storage_pool_mc::bind_f<LocalDomains>{cursor, n, local_domains}, tmps);
+        fun();
+    }
+} // namespace gridtools
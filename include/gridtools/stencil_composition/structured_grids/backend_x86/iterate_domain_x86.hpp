@@ -11,20 +11,91 @@
 
 #include <utility>
 
+#include <boost/fusion/include/as_map.hpp>
+#include <boost/fusion/include/at_key.hpp>
+#include <boost/fusion/include/std_tuple.hpp>
+
 #include "../../../common/defs.hpp"
 #include "../../../common/host_device.hpp"
+#include "../../../meta.hpp"
+#include "../../caches/cache_metafunctions.hpp"
+#include "../../caches/iterate_domain_cache_aux.hpp"
 #include "../../iterate_domain_fwd.hpp"
+#include "../../iteration_policy.hpp"
 #include "../iterate_domain.hpp"
 
 namespace gridtools {
     /**
      * @brief iterate domain class for the X86 backend
+     *
+     * k caches are kept as ring buffers inside of the iterate domain, that is on the stack of the thread executing the
+     * k loop of the current (i, j) column.
      */
     template <typename IterateDomainArguments>
     struct iterate_domain_x86 : iterate_domain<IterateDomainArguments> {
+      private:
+        using cache_sequence_t = typename IterateDomainArguments::local_domain_t::cache_sequence_t;
+        using k_cache_args_t = GT_META_CALL(k_cache_args, cache_sequence_t);
+
+        using k_caches_tuple_t =
+            typename boost::fusion::result_of::as_map<typename get_k_cache_storage_tuple<cache_sequence_t,
+                typename IterateDomainArguments::esf_sequence_t>::type>::type;
+
+        k_caches_tuple_t m_k_caches_tuple;
+
+      public:
+        static constexpr bool has_k_caches = !meta::is_empty<GT_META_CALL(k_caches, cache_sequence_t)>::value;
+
         using iterate_domain<IterateDomainArguments>::iterate_domain;
 
-        template <class Arg, class Accessor>
+        /**
+         * @brief all (i, j) positions visited by the x86 mss loop are inside of the domain of the current mss
+         */
+        template <typename Extent>
+        GT_FORCE_INLINE bool is_thread_in_domain() const {
+            return true;
+        }
+
+        template <typename IterationPolicy>
+        GT_FORCE_INLINE void slide_caches() {
+            GT_STATIC_ASSERT(is_iteration_policy<IterationPolicy>::value, GT_INTERNAL_ERROR);
+            _impl::slide_caches<k_cache_args_t, typename IterationPolicy::execution_type>(m_k_caches_tuple);
+        }
+
+        /**
+         * fill next k level from main memory for all k caches. The position of the kcache being filled
+         * depends on the iteration policy
+         * \tparam IterationPolicy forward: backward
+         */
+        template <typename IterationPolicy>
+        GT_FORCE_INLINE void fill_caches(bool first_level) {
+            GT_STATIC_ASSERT(is_iteration_policy<IterationPolicy>::value, GT_INTERNAL_ERROR);
+            using filling_cache_args_t = GT_META_CALL(
+                meta::transform, (cache_parameter, GT_META_CALL(meta::filter, (is_filling_cache, cache_sequence_t))));
+            _impl::sync_caches<filling_cache_args_t, typename IterationPolicy::execution_type, sync_type::fill>(
+                *this, m_k_caches_tuple, first_level);
+        }
+
+        /**
+         * flush the last k level of the ring buffer into main memory. The position of the kcache being flushed
+         * depends on the iteration policy
+         * \tparam IterationPolicy forward: backward
+         */
+        template <typename IterationPolicy>
+        GT_FORCE_INLINE void flush_caches(bool last_level) {
+            GT_STATIC_ASSERT(is_iteration_policy<IterationPolicy>::value, GT_INTERNAL_ERROR);
+            using flushing_cache_args_t = GT_META_CALL(
+                meta::transform, (cache_parameter, GT_META_CALL(meta::filter, (is_flushing_cache, cache_sequence_t))));
+            _impl::sync_caches<flushing_cache_args_t, typename IterationPolicy::execution_type, sync_type::flush>(
+                *this, m_k_caches_tuple, last_level);
+        }
+
+        template <class Arg, class Accessor, enable_if_t<meta::st_contains<k_cache_args_t, Arg>::value, int> = 0>
+        GT_FORCE_INLINE typename Arg::data_store_t::data_t &deref(Accessor const &acc) const {
+            return boost::fusion::at_key<Arg>(const_cast<k_caches_tuple_t &>(m_k_caches_tuple)).at(acc);
+        }
+
+        template <class Arg, class Accessor, enable_if_t<!meta::st_contains<k_cache_args_t, Arg>::value, int> = 0>
         GT_FORCE_INLINE auto deref(Accessor const &acc) const GT_AUTO_RETURN(*this->template get_ptr<Arg>(acc));
     };
 
@@ -12,6 +12,7 @@
 #include "../../backend_x86/basic_token_execution_x86.hpp"
 #include "../../iteration_policy.hpp"
 #include "../../pos3.hpp"
+#include "../../stage_meters.hpp"
 #include "../positional_iterate_domain.hpp"
 #include "./iterate_domain_x86.hpp"
 #include "./run_esf_functor_x86.hpp"
@@ -62,6 +63,13 @@ namespace gridtools {
         const uint_t size_j = block_size_f(total_j, block_j_size(backend_target), execution_info.bj) +
                               extent_t::jplus::value - extent_t::jminus::value;
 
+        // the backend does not fuse stages, so there is one stage
+        using stages_t = GT_META_CALL(meta::dedup,
+            (GT_META_CALL(meta::flatten,
+                (GT_META_CALL(meta::flatten,
+                    (GT_META_CALL(meta::transform, (meta::third, typename RunFunctorArgs::loop_intervals_t))))))));
+        scoped_stage_meter<GT_META_CALL(meta::first, stages_t)> meter;
+
         // run the nested ij loop
         for (uint_t i = 0; i != size_i; ++i) {
             auto irestore_index = it_domain.index();
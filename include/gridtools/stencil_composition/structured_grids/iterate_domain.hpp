@@ -96,6 +96,26 @@ namespace gridtools {
             increment<dim::k>(offset);
         }
 
+        /**
+         * @brief returns a pointer to the element of the given field at the given k offset from the current position,
+         * or nullptr if that element lies outside of the storage. Used to fill and flush k caches.
+         */
+        template <class Arg, class DataStore = typename Arg::data_store_t, class Data = typename DataStore::data_t>
+        GT_FUNCTION Data *deref_for_k_cache(int_t k_offset) const {
+            using storage_info_t = typename DataStore::storage_info_t;
+            static constexpr auto storage_info_index =
+                meta::st_position<typename local_domain_t::strides_kinds_t, storage_info_t>::value;
+
+            auto offset = m_index[storage_info_index];
+            sid::shift(offset,
+                sid::get_stride<dim::k>(host_device::at_key<storage_info_t>(m_local_domain.m_strides_map)),
+                k_offset);
+
+            return offset < host_device::at_key<storage_info_t>(m_local_domain.m_total_length_map) && offset >= 0
+                       ? host_device::at_key<Arg>(m_ptr_map) + offset
+                       : nullptr;
+        }
+
         /**@brief method for initializing the index */
         GT_FUNCTION void initialize(pos3<uint_t> begin, pos3<uint_t> block_no, pos3<int_t> pos_in_block) {
             using backend_t = typename IterateDomainArguments::backend_t;
@@ -0,0 +1,172 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "../common/defs.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "../common/tuple_util.hpp"
+#include "arg.hpp"
+#include "grid.hpp"
+#include "intermediate_impl.hpp"
+
+/**
+ * @file
+ * Temporal blocking of explicit time stepping on structured grids, see `run_temporally_blocked`.
+ */
+
+namespace gridtools {
+
+    /**
+     *  The shape of the tiles of `run_temporally_blocked`: `steps` time steps are run on a tile of `i_size` x `j_size`
+     *  points (before skewing) before moving to the next tile. A zero size means the whole compute domain.
+     */
+    struct temporal_blocking {
+        uint_t steps;
+        uint_t i_size;
+        uint_t j_size;
+    };
+
+    namespace temporal_blocking_impl_ {
+        template <class Extent>
+        constexpr uint_t i_skew() {
+            return -Extent::iminus::value > Extent::iplus::value ? -Extent::iminus::value : Extent::iplus::value;
+        }
+
+        template <class Extent>
+        constexpr uint_t j_skew() {
+            return -Extent::jminus::value > Extent::jplus::value ? -Extent::jminus::value : Extent::jplus::value;
+        }
+
+        /**
+         *  The tiles of one dimension of the compute domain. Tile `tile` at the time step `step` of a block covers
+         *  [first(tile, step), last(tile, step)], which is empty if first > last.
+         */
+        struct skewed_tiles {
+            int_t m_begin;
+            int_t m_end;
+            int_t m_skew;
+            int_t m_size;
+            int_t m_count;
+
+            skewed_tiles(halo_descriptor const &direction, uint_t size, uint_t skew, uint_t steps)
+                : m_begin(direction.begin()), m_end(direction.end()), m_skew(skew) {
+                // in the skewed coordinates the tiles cover the compute domain shifted by up to (steps - 1) * skew
+                int_t length = m_end - m_begin + 1 + (steps - 1) * m_skew;
+                m_size = size == 0 ? length : size;
+                m_count = (length + m_size - 1) / m_size;
+            }
+
+            int_t count() const { return m_count; }
+            int_t first(int_t tile, int_t step) const {
+                return std::max(m_begin, m_begin + tile * m_size - step * m_skew);
+            }
+            int_t last(int_t tile, int_t step) const {
+                return std::min(m_end, m_begin + (tile + 1) * m_size - 1 - step * m_skew);
+            }
+        };
+
+        template <class Grid>
+        Grid sub_grid(Grid const &grid, int_t i_first, int_t i_last, int_t j_first, int_t j_last) {
+            auto const &i = grid.direction_i();
+            auto const &j = grid.direction_j();
+            return Grid{halo_descriptor(i.minus(), i.plus(), i_first, i_last, i.total_length()),
+                halo_descriptor(j.minus(), j.plus(), j_first, j_last, j.total_length()),
+                grid.value_list};
+        }
+
+        template <class Comp, class LocalDomains, class Grid>
+        void run_steps(Comp &comp,
+            LocalDomains *local_domains,
+            Grid const &grid,
+            temporal_blocking const &blocking,
+            uint_t i_skew,
+            uint_t j_skew,
+            uint_t first_step,
+            uint_t steps) {
+            skewed_tiles i_tiles(grid.direction_i(), blocking.i_size, i_skew, steps);
+            skewed_tiles j_tiles(grid.direction_j(), blocking.j_size, j_skew, steps);
+            for (int_t i_tile = 0; i_tile != i_tiles.count(); ++i_tile)
+                for (int_t j_tile = 0; j_tile != j_tiles.count(); ++j_tile)
+                    for (int_t step = 0; step != (int_t)steps; ++step) {
+                        int_t i_first = i_tiles.first(i_tile, step);
+                        int_t i_last = i_tiles.last(i_tile, step);
+                        int_t j_first = j_tiles.first(j_tile, step);
+                        int_t j_last = j_tiles.last(j_tile, step);
+                        if (i_first > i_last || j_first > j_last)
+                            continue;
+                        comp.run_local_domains(local_domains[(first_step + step) % 2],
+                            sub_grid(grid, i_first, i_last, j_first, j_last));
+                    }
+        }
+    } // namespace temporal_blocking_impl_
+
+    /**
+     *  Runs `steps` time steps of an explicit scheme with the usual swap rule: each time step reads `in` and writes
+     *  `out`, then the two storages are swapped. The result is bitwise identical to
+     *
+     *  \code
+     *  for (uint_t t = 0; t < steps; ++t) {
+     *      comp.run(p_in = in, p_out = out, other_args...);
+     *      std::swap(in, out);
+     *  }
+     *  \endcode
+     *
+     *  but the time steps are blocked in time: the grid is split in tiles of `blocking.i_size` x `blocking.j_size`
+     *  points and `blocking.steps` time steps are run on a tile before moving to the next one, so that the fields stay
+     *  in cache between time steps. Since a time step reads its input with the extent of `p_in`, the tiles are skewed
+     *  by this extent at every time step and they are run in order. This makes the tiles parallelograms in space-time
+     *  which only depend on tiles that have already been run, and which only overwrite values of the previous time
+     *  steps that are no longer read. Every tile is a run of the computation on a part of the grid, the threads
+     *  share the blocks of a tile as usual.
+     *
+     *  `comp` should be made by `make_computation` with the grid of the time stepping and a single storage type for
+     *  `p_in` and `p_out`. The compute domain is not written by anything else than the computation, the halos of
+     *  the two storages should not depend on the time step.
+     */
+    template <class Comp, class In, class Out, class DataStore, class... Args, class... DataStores>
+    void run_temporally_blocked(Comp &comp,
+        uint_t steps,
+        temporal_blocking const &blocking,
+        In p_in,
+        DataStore &in,
+        Out p_out,
+        DataStore &out,
+        arg_storage_pair<Args, DataStores> const &... other_args) {
+        GT_STATIC_ASSERT(is_plh<In>::value && is_plh<Out>::value, "p_in and p_out should be placeholders");
+        assert(blocking.steps > 0);
+
+        using in_extent_t = decltype(comp.get_arg_extent(p_in));
+        using out_extent_t = decltype(comp.get_arg_extent(p_out));
+        uint_t i_skew = std::max(temporal_blocking_impl_::i_skew<in_extent_t>(),
+            temporal_blocking_impl_::i_skew<out_extent_t>());
+        uint_t j_skew = std::max(temporal_blocking_impl_::j_skew<in_extent_t>(),
+            temporal_blocking_impl_::j_skew<out_extent_t>());
+
+        // the local domains of the even and the odd time steps
+        typename Comp::local_domains_t local_domains[2] = {
+            comp.local_domains(p_in = in, p_out = out, other_args...),
+            comp.local_domains(p_in = out, p_out = in, other_args...)};
+        _impl::sync_data_store_f sync;
+        sync(in);
+        sync(out);
+        (void)(int[]){0, ((void)sync(other_args), 0)...};
+
+        auto const &grid = comp.grid();
+        for (uint_t step = 0; step < steps; step += blocking.steps)
+            temporal_blocking_impl_::run_steps(
+                comp, local_domains, grid, blocking, i_skew, j_skew, step, std::min(blocking.steps, steps - step));
+        if (steps % 2)
+            std::swap(in, out);
+    }
+} // namespace gridtools
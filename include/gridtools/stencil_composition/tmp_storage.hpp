@@ -30,6 +30,7 @@
  *    1. get_i_size, get_j_size, and optionally get_k_size
  *    2. get_i_block_offset, get_j_block_offset and optionally get_k_block_offset
  *    3. make_storage_info
+ *    4. optionally uses_tmp_storage_pool and run_with_tmp_storages
  *
  *    Signatures:
  *    StorageInfo make_storage_info<StorageInfo, NColors>(uint_t i_size, uint_t j_size, uint_t k_size);
@@ -75,17 +76,47 @@ namespace gridtools {
             return {};
         }
 
+        template <class Backend>
+        constexpr std::false_type uses_tmp_storage_pool(Backend const &) {
+            return {};
+        }
+
         template <class MaxExtent, class ArgTag, class DataStore, int_t I, uint_t NColors, class Backend, class Grid>
-        DataStore make_tmp_data_store(
+        typename DataStore::storage_info_t make_tmp_storage_info(
             Backend backend, plh<ArgTag, DataStore, location_type<I, NColors>, true>, Grid const &grid) {
             GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
             using storage_info_t = typename DataStore::storage_info_t;
-            return {make_storage_info<storage_info_t, NColors>(backend,
+            return make_storage_info<storage_info_t, NColors>(backend,
                 get_i_size<storage_info_t, MaxExtent>(
                     backend, block_i_size(backend, grid), grid.i_high_bound() - grid.i_low_bound() + 1),
                 get_j_size<storage_info_t, MaxExtent>(
                     backend, block_j_size(backend, grid), grid.j_high_bound() - grid.j_low_bound() + 1),
-                get_k_size<storage_info_t, MaxExtent>(backend, block_k_size(backend, grid), grid.k_total_length()))};
+                get_k_size<storage_info_t, MaxExtent>(backend, block_k_size(backend, grid), grid.k_total_length()));
+        }
+
+        template <class MaxExtent, class ArgTag, class DataStore, int_t I, uint_t NColors, class Backend, class Grid>
+        DataStore make_tmp_data_store(
+            Backend backend, plh<ArgTag, DataStore, location_type<I, NColors>, true> arg, Grid const &grid) {
+            return {make_tmp_storage_info<MaxExtent>(backend, arg, grid)};
+        }
+
+        /**
+         * Temporaries of backends that use a temporary storage pool are created without memory. Their memory is bound
+         * to the local domains for the duration of each run.
+         */
+        template <class MaxExtent, class ArgTag, class DataStore, int_t I, uint_t NColors, class Backend, class Grid>
+        DataStore make_pooled_tmp_data_store(
+            Backend backend, plh<ArgTag, DataStore, location_type<I, NColors>, true> arg, Grid const &grid) {
+            return DataStore{make_tmp_storage_info<MaxExtent>(backend, arg, grid), (typename DataStore::data_t *)0};
+        }
+
+        /**
+         * Runs `fun` with the memory of all temporaries bound to the local domains. Temporaries own their memory
+         * unless the backend uses a temporary storage pool.
+         */
+        template <class Backend, class TmpArgStoragePairs, class LocalDomains, class Fun>
+        void run_with_tmp_storages(Backend const &, TmpArgStoragePairs const &, LocalDomains &, Fun &&fun) {
+            fun();
         }
     } // namespace tmp_storage
 
@@ -123,4 +154,8 @@ namespace gridtools {
     GT_META_DEFINE_ALIAS(
         needs_allocate_cached_tmp, meta::id, decltype(::gridtools::tmp_storage::needs_allocate_cached_tmp(Backend{})));
 
+    template <class Backend>
+    GT_META_DEFINE_ALIAS(
+        uses_tmp_storage_pool, meta::id, decltype(::gridtools::tmp_storage::uses_tmp_storage_pool(Backend{})));
+
 } // namespace gridtools
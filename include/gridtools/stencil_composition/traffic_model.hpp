@@ -0,0 +1,163 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "../common/defs.hpp"
+#include "../common/generic_metafunctions/for_each.hpp"
+#include "../meta.hpp"
+#include "compute_extents_metafunctions.hpp"
+#include "esf_metafunctions.hpp"
+
+/**
+ * @file
+ * A static roofline model of a computation, see `traffic_model`.
+ */
+
+namespace gridtools {
+
+    /**
+     *  The theoretical minimum memory traffic and the operation count of one run of a computation.
+     *
+     *  Every (non temporary) field that is read is loaded once, on the compute domain extended by its extent, every
+     *  field that is written is stored once on the compute domain. Temporaries are assumed to stay in cache and global
+     *  parameters count for one value. The operations are the ones declared by the stage functors as
+     *  `using flops = expr_flops<...>;` (or any integral constant), per point of the compute domain. If a functor
+     *  does not declare its operations, `has_flops` is false and `flops` only counts the other functors.
+     */
+    struct traffic_model {
+        double bytes_read = 0;
+        double bytes_written = 0;
+        double flops = 0;
+        bool has_flops = true;
+
+        double bytes() const { return bytes_read + bytes_written; }
+
+        /// flops per byte of the minimum memory traffic
+        double arithmetic_intensity() const { return bytes() > 0 ? flops / bytes() : 0; }
+
+        traffic_model &operator+=(traffic_model const &other) {
+            bytes_read += other.bytes_read;
+            bytes_written += other.bytes_written;
+            flops += other.flops;
+            has_flops = has_flops && other.has_flops;
+            return *this;
+        }
+
+        traffic_model &operator*=(double factor) {
+            bytes_read *= factor;
+            bytes_written *= factor;
+            flops *= factor;
+            return *this;
+        }
+
+        std::string to_string() const {
+            std::ostringstream out;
+            out << "bytes read: " << bytes_read << ", bytes written: " << bytes_written << ", flops: ";
+            if (has_flops)
+                out << flops;
+            else
+                out << "unknown";
+            return out.str();
+        }
+    };
+
+    namespace traffic_model_impl_ {
+        template <class Functor, class = void>
+        struct functor_flops : std::integral_constant<int_t, 0> {
+            static constexpr bool has_flops = false;
+        };
+
+        template <class Functor>
+        struct functor_flops<Functor, void_t<typename Functor::flops>>
+            : std::integral_constant<int_t, Functor::flops::value> {
+            static constexpr bool has_flops = true;
+        };
+
+#ifndef GT_ICOSAHEDRAL_GRIDS
+        template <class Esf>
+        using esf_functor = typename Esf::esf_function_t;
+
+        template <class Esf>
+        using esf_colors = std::integral_constant<uint_t, 1>;
+#else
+        template <class Esf>
+        using esf_functor = typename Esf::template esf_function<0>;
+
+        template <class Esf>
+        using esf_colors = std::integral_constant<uint_t, Esf::location_type::n_colors::value>;
+#endif
+
+        template <class Grid, class Extent>
+        double points(Grid const &grid, Extent) {
+            auto const &i = grid.direction_i();
+            auto const &j = grid.direction_j();
+            return double(i.end() - i.begin() + 1 + Extent::iplus::value - Extent::iminus::value) *
+                   (j.end() - j.begin() + 1 + Extent::jplus::value - Extent::jminus::value) *
+                   (grid.k_total_length() + Extent::kplus::value - Extent::kminus::value);
+        }
+
+        template <class Placeholder>
+        using is_global_parameter =
+            bool_constant<Placeholder::data_store_t::storage_info_t::layout_t::unmasked_length == 0>;
+
+        template <class ExtentMap, class ReadArgs, class RwArgs, class Grid>
+        struct add_bytes_f {
+            traffic_model &m_model;
+            Grid const &m_grid;
+
+            template <class Placeholder>
+            void operator()() const {
+                using data_t = typename Placeholder::data_store_t::data_t;
+                double colors = Placeholder::location_t::n_colors::value;
+                if (is_global_parameter<Placeholder>::value) {
+                    m_model.bytes_read += sizeof(data_t);
+                    return;
+                }
+                if (meta::st_contains<ReadArgs, Placeholder>::value)
+                    m_model.bytes_read += colors * sizeof(data_t) *
+                                          points(m_grid, GT_META_CALL(lookup_extent_map, (ExtentMap, Placeholder)){});
+                if (meta::st_contains<RwArgs, Placeholder>::value)
+                    m_model.bytes_written += colors * sizeof(data_t) * points(m_grid, extent<>{});
+            }
+        };
+
+        template <class Grid>
+        struct add_flops_f {
+            traffic_model &m_model;
+            Grid const &m_grid;
+
+            template <class Esf>
+            void operator()() const {
+                using flops_t = functor_flops<esf_functor<Esf>>;
+                m_model.flops += double(flops_t::value) * esf_colors<Esf>::value * points(m_grid, extent<>{});
+                m_model.has_flops = m_model.has_flops && flops_t::has_flops;
+            }
+        };
+    } // namespace traffic_model_impl_
+
+    /**
+     *  The traffic model of the stages `Esfs` on the grid. `ExtentMap` maps the placeholders to their extents,
+     *  `Placeholders` are the non temporary placeholders of the stages.
+     */
+    template <class Esfs, class ExtentMap, class Placeholders, class Grid>
+    traffic_model make_traffic_model(Grid const &grid) {
+        using read_args_t = GT_META_CALL(compute_read_args, Esfs);
+        using rw_args_t = GT_META_CALL(compute_readwrite_args, Esfs);
+        traffic_model res;
+        for_each_type<Placeholders>(
+            traffic_model_impl_::add_bytes_f<ExtentMap, read_args_t, rw_args_t, Grid>{res, grid});
+        for_each_type<Esfs>(traffic_model_impl_::add_flops_f<Grid>{res, grid});
+        return res;
+    }
+} // namespace gridtools
@@ -87,8 +87,28 @@ namespace gridtools {
          * @return true if the storage is valid, false otherwise
          */
         bool valid() const { return static_cast<Derived const *>(this)->valid_impl(); }
+
+        /*
+         * @brief This method places the memory of a freshly allocated storage (e.g., on NUMA nodes) before it is
+         * initialized. The storage info describes the layout of the data. Storages that do not provide a placement
+         * leave the memory untouched.
+         */
+        template <typename StorageInfo>
+        void place(StorageInfo const &info) {
+            static_cast<Derived *>(this)->place_impl(info);
+        }
+
+        template <typename StorageInfo>
+        void place_impl(StorageInfo const &) {}
     };
 
+    /*
+     * @brief Storages that place their memory in `place` specialize this trait to true_type and provide a method
+     * initialize(size, initializer), which initializes the placed memory like the initializing storage constructor.
+     */
+    template <typename T>
+    struct storage_has_placement : std::false_type {};
+
     template <typename T>
     struct is_storage : std::is_base_of<storage_interface<T>, T> {};
 
@@ -120,7 +120,9 @@ namespace gridtools {
         data_store(StorageInfo const &info, std::string const &name = "")
             : m_shared_storage(new storage_t(
                   info.padded_total_length(), info.first_index_of_inner_region(), typename StorageInfo::alignment_t{})),
-              m_shared_storage_info(new storage_info_t(info)), m_name(name) {}
+              m_shared_storage_info(new storage_info_t(info)), m_name(name) {
+            m_shared_storage->place(info);
+        }
 
         /**
          * @brief data_store constructor. This constructor triggers an allocation of the required space.
@@ -129,6 +131,7 @@ namespace gridtools {
          * @param initializer initialization value
          * @param name Human readable name for the data_store
          */
+        template <class S = storage_t, enable_if_t<!storage_has_placement<S>::value, int> = 0>
         GT_CONSTEXPR data_store(StorageInfo const &info, data_t initializer, std::string const &name = "")
             : m_shared_storage(new storage_t(info.padded_total_length(),
                   [initializer](int) { return initializer; },
@@ -136,6 +139,19 @@ namespace gridtools {
                   typename StorageInfo::alignment_t{})),
               m_shared_storage_info(new storage_info_t(info)), m_name(name) {}
 
+        /**
+         * @brief data_store constructor for storages that place their memory (see storage_interface::place). The
+         * memory is placed before it is initialized to the given value, so the initialization does not touch it first.
+         * @param info storage info instance
+         * @param initializer initialization value
+         * @param name Human readable name for the data_store
+         */
+        template <class S = storage_t, enable_if_t<storage_has_placement<S>::value, int> = 0>
+        data_store(StorageInfo const &info, data_t initializer, std::string const &name = "")
+            : data_store(info, name) {
+            m_shared_storage->initialize(info.padded_total_length(), [initializer](int) { return initializer; });
+        }
+
         /**
          * @brief data_store constructor. This constructor triggers an allocation of the required space.
          * Additionally the data is initialized with the given value. Current i, j, k, etc. is passed
@@ -151,6 +167,7 @@ namespace gridtools {
             : m_shared_storage(new storage_t(
                   info.padded_total_length(), info.first_index_of_inner_region(), typename StorageInfo::alignment_t{})),
               m_shared_storage_info(new storage_info_t(info)), m_name(name) {
+            m_shared_storage->place(info);
             // initialize the storage with the given lambda
             data_store_impl_::lambda_initializer(
                 std::forward<Initializer>(initializer), info, m_shared_storage->get_cpu_ptr());
@@ -211,6 +228,7 @@ namespace gridtools {
             m_shared_storage = std::make_shared<storage_t>(m_shared_storage_info->padded_total_length(),
                 m_shared_storage_info->first_index_of_inner_region(),
                 typename StorageInfo::alignment_t{});
+            m_shared_storage->place(info);
         }
 
         /**
@@ -17,6 +17,7 @@
 #include "../../common/hugepage_alloc.hpp"
 #include "../common/state_machine.hpp"
 #include "../common/storage_interface.hpp"
+#include "numa_placement_mc.hpp"
 
 namespace gridtools {
 
@@ -31,9 +32,10 @@ namespace gridtools {
      * but we prefer the CRTP because it can be seen as the standard
      * gridtools pattern and we clearly want to avoid virtual
      * methods, etc.
+     * @tparam Placement NUMA placement policy of the allocated memory (see numa_placement_mc.hpp)
      */
-    template <typename DataType>
-    struct mc_storage : storage_interface<mc_storage<DataType>> {
+    template <typename DataType, typename Placement = numa_placement_mc::GT_MC_NUMA_PLACEMENT>
+    struct mc_storage : storage_interface<mc_storage<DataType, Placement>> {
         typedef DataType data_t;
         typedef state_machine state_machine_t;
 
@@ -78,6 +80,16 @@ namespace gridtools {
         template <typename Fun, uint_t Align = 1>
         mc_storage(uint_t size, Fun &&initializer, uint_t offset_to_align = 0u, alignment<Align> a = alignment<1u>{})
             : mc_storage(size, offset_to_align, a) {
+            initialize(size, initializer);
+        }
+
+        /*
+         * @brief Initializes the memory according to the given initializer.
+         * @param size defines the size of the storage
+         * @param initializer initialization value
+         */
+        template <typename Fun>
+        void initialize(uint_t size, Fun &&initializer) {
 #pragma ivdep
 #ifdef _OPENMP
 #pragma omp parallel for simd
@@ -86,6 +98,15 @@ namespace gridtools {
                 m_ptr[i] = initializer(i);
         }
 
+        /*
+         * @brief place implementation for mc_storage. Applies the NUMA placement policy to owned memory.
+         */
+        template <typename StorageInfo>
+        void place_impl(StorageInfo const &info) {
+            if (m_holder)
+                numa_place_mc(Placement{}, info, m_ptr);
+        }
+
         /*
          * @brief swap implementation for mc_storage
          */
@@ -152,6 +173,10 @@ namespace gridtools {
     template <typename T>
     struct is_mc_storage : std::false_type {};
 
-    template <typename T>
-    struct is_mc_storage<mc_storage<T>> : std::true_type {};
+    template <typename T, typename Placement>
+    struct is_mc_storage<mc_storage<T, Placement>> : std::true_type {};
+
+    template <typename T, typename Placement>
+    struct storage_has_placement<mc_storage<T, Placement>>
+        : std::integral_constant<bool, !std::is_same<Placement, numa_placement_mc::none>::value> {};
 } // namespace gridtools
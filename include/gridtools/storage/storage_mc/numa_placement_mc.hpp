@@ -0,0 +1,204 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include <omp.h>
+
+#ifdef GT_MC_USE_LIBNUMA
+#include <numa.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "../../common/defs.hpp"
+#include "../../common/execinfo_mc.hpp"
+
+/**@file
+ * @brief NUMA placement policies of mc storages.
+ *
+ * Linux places a memory page on the NUMA node of the thread that touches it first. A placement policy decides how
+ * the pages of a freshly allocated mc storage are touched (or bound explicitly using libnuma) before the storage is
+ * initialized. The default policy of `mc_storage` can be set by defining GT_MC_NUMA_PLACEMENT to the name of one of
+ * the policies below, e.g. `-DGT_MC_NUMA_PLACEMENT=first_touch`. The policies `interleave` and `bind` require
+ * libnuma, which is used if GT_MC_USE_LIBNUMA is defined.
+ */
+
+#ifndef GT_MC_NUMA_PLACEMENT
+#define GT_MC_NUMA_PLACEMENT none
+#endif
+
+namespace gridtools {
+    namespace numa_placement_mc {
+        /**
+         * @brief Pages are placed where they are touched first, usually by the initialization of the data store.
+         */
+        struct none {};
+
+        /**
+         * @brief Pages are touched by the threads that compute the respective blocks of the domain in `fused_mss_loop`
+         * with the default (static) block decomposition of the mc backend.
+         */
+        struct first_touch {};
+
+        /**
+         * @brief Pages are interleaved round-robin over all NUMA nodes.
+         */
+        struct interleave {};
+
+        /**
+         * @brief Like `first_touch`, but the pages of each block are explicitly bound to the NUMA node of the thread
+         * that computes the block. Falls back to `first_touch` if the j-dimension is not the outermost dimension.
+         */
+        struct bind {};
+    } // namespace numa_placement_mc
+
+    namespace _impl_numa_placement_mc {
+        /**
+         * @brief Inner region of a storage, used as grid to get the same block decomposition as the stencils.
+         */
+        template <class StorageInfo>
+        struct inner_region {
+            StorageInfo const &m_info;
+
+            int_t i_low_bound() const { return m_info.template begin<0>(); }
+            int_t i_high_bound() const { return m_info.template end<0>(); }
+            int_t j_low_bound() const { return m_info.template begin<1>(); }
+            int_t j_high_bound() const { return m_info.template end<1>(); }
+        };
+
+        template <class T>
+        void touch_linear(T *ptr, int_t size) {
+#pragma omp parallel for
+            for (int_t i = 0; i < size; ++i)
+                ptr[i] = T();
+        }
+
+        /**
+         * @brief Touches all elements with i in [i_first, i_last) and j in [j_first, j_last).
+         */
+        template <class StorageInfo, class T>
+        void touch_block(StorageInfo const &info, T *ptr, int_t i_first, int_t i_last, int_t j_first, int_t j_last) {
+            constexpr int_t ndims = StorageInfo::layout_t::masked_length;
+            auto const &strides = info.strides();
+            auto const &lengths = info.total_lengths();
+
+            // number of points in all remaining dimensions (k, ...); masked dimensions have no extent in memory
+            int_t outer_size = 1;
+            for (int_t d = 2; d < ndims; ++d)
+                outer_size *= strides[d] ? lengths[d] : 1;
+
+            for (int_t j = j_first; j < j_last; ++j) {
+                for (int_t n = 0; n < outer_size; ++n) {
+                    int_t offset = j * strides[1];
+                    int_t rest = n;
+                    for (int_t d = 2; d < ndims; ++d) {
+                        if (!strides[d])
+                            continue;
+                        offset += rest % lengths[d] * strides[d];
+                        rest /= lengths[d];
+                    }
+                    for (int_t i = i_first; i < i_last; ++i)
+                        ptr[offset + i * strides[0]] = T();
+                }
+            }
+        }
+
+#ifdef GT_MC_USE_LIBNUMA
+        inline std::uintptr_t page_ceil(void const *ptr) {
+            static const std::uintptr_t page_size = sysconf(_SC_PAGESIZE);
+            return (reinterpret_cast<std::uintptr_t>(ptr) + page_size - 1) / page_size * page_size;
+        }
+
+        /**
+         * @brief Binds the pages starting in [begin, end) to the NUMA node of the calling thread.
+         */
+        inline void bind_to_local_node(void const *begin, void const *end) {
+            std::uintptr_t first = page_ceil(begin), last = page_ceil(end);
+            int node = numa_node_of_cpu(sched_getcpu());
+            if (last > first && node >= 0)
+                numa_tonode_memory(reinterpret_cast<void *>(first), last - first, node);
+        }
+#endif
+
+        template <class StorageInfo, class T, enable_if_t<(StorageInfo::layout_t::masked_length < 2), int> = 0>
+        void touch_blocks(StorageInfo const &info, T *ptr, bool) {
+            touch_linear(ptr, info.padded_total_length());
+        }
+
+        /**
+         * @brief Touches all blocks of the storage with the same block-to-thread mapping as `fused_mss_loop`. Halo
+         * points are touched together with the adjacent boundary blocks.
+         */
+        template <class StorageInfo, class T, enable_if_t<(StorageInfo::layout_t::masked_length >= 2), int> = 0>
+        void touch_blocks(StorageInfo const &info, T *ptr, bool bind) {
+            auto const &strides = info.strides();
+            if (!strides[0] || !strides[1] || info.template length<0>() == 0 || info.template length<1>() == 0) {
+                touch_linear(ptr, info.padded_total_length());
+                return;
+            }
+            // blocks can only be bound if they are contiguous in memory
+            for (auto stride : strides)
+                bind = bind && stride <= strides[1];
+
+            execinfo_mc exinfo(inner_region<StorageInfo>{info});
+            const int_t i_blocks = exinfo.i_blocks();
+            const int_t j_blocks = exinfo.j_blocks();
+            const int_t i_size = info.template total_length<0>();
+            const int_t j_size = info.template total_length<1>();
+            bind = bind && i_blocks == 1;
+#pragma omp parallel for collapse(2)
+            for (int_t bj = 0; bj < j_blocks; ++bj) {
+                for (int_t bi = 0; bi < i_blocks; ++bi) {
+                    auto block = exinfo.block(bi, bj);
+                    int_t i_first = bi == 0 ? 0 : block.i_first;
+                    int_t i_last = bi == i_blocks - 1 ? i_size : block.i_first + block.i_block_size;
+                    int_t j_first = bj == 0 ? 0 : block.j_first;
+                    int_t j_last = bj == j_blocks - 1 ? j_size : block.j_first + block.j_block_size;
+#ifdef GT_MC_USE_LIBNUMA
+                    if (bind)
+                        bind_to_local_node(ptr + j_first * strides[1], ptr + j_last * strides[1]);
+#endif
+                    touch_block(info, ptr, i_first, i_last, j_first, j_last);
+                }
+            }
+        }
+    } // namespace _impl_numa_placement_mc
+
+    template <class StorageInfo, class T>
+    void numa_place_mc(numa_placement_mc::none, StorageInfo const &, T *) {}
+
+    template <class StorageInfo, class T>
+    void numa_place_mc(numa_placement_mc::first_touch, StorageInfo const &info, T *ptr) {
+        _impl_numa_placement_mc::touch_blocks(info, ptr, false);
+    }
+
+    template <class StorageInfo, class T>
+    void numa_place_mc(numa_placement_mc::interleave, StorageInfo const &info, T *ptr) {
+#ifdef GT_MC_USE_LIBNUMA
+        if (numa_available() >= 0)
+            numa_interleave_memory(ptr, info.padded_total_length() * sizeof(T), numa_all_nodes_ptr);
+        _impl_numa_placement_mc::touch_linear(ptr, info.padded_total_length());
+#else
+        GT_STATIC_ASSERT(sizeof(T) == 0, "interleaved NUMA placement requires libnuma (GT_MC_USE_LIBNUMA)");
+#endif
+    }
+
+    template <class StorageInfo, class T>
+    void numa_place_mc(numa_placement_mc::bind, StorageInfo const &info, T *ptr) {
+#ifdef GT_MC_USE_LIBNUMA
+        _impl_numa_placement_mc::touch_blocks(info, ptr, numa_available() >= 0);
+#else
+        GT_STATIC_ASSERT(sizeof(T) == 0, "bound NUMA placement requires libnuma (GT_MC_USE_LIBNUMA)");
+#endif
+    }
+} // namespace gridtools
@@ -183,7 +183,8 @@ namespace gridtools {
         template <class Expected, class Actual>
         void verify(
             Expected const &expected, Actual const &actual, double precision = default_precision<float_type>()) const {
-            EXPECT_TRUE(verifier{precision}.verify(make_grid(), expected, actual, halos<Expected>()));
+            auto res = verifier{precision}.compare(make_grid(), expected, actual, halos<Expected>());
+            EXPECT_TRUE(res.passed()) << res;
         }
     };
 
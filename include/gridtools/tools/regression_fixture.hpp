@@ -9,15 +9,42 @@
  */
 #pragma once
 
+#include <chrono>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include "../common/defs.hpp"
+#ifdef __CUDACC__
+#include "../common/cuda_util.hpp"
+#endif
 #include "../stencil_composition/axis.hpp"
 #include "computation_fixture.hpp"
 #include "regression_fixture_impl.hpp"
 
 namespace gridtools {
+    namespace _impl {
+        inline char const *regression_backend_name() {
+#if defined(GT_BACKEND_X86)
+            return "x86";
+#elif defined(GT_BACKEND_NAIVE)
+            return "naive";
+#elif defined(GT_BACKEND_MC)
+            return "mc";
+#elif defined(GT_BACKEND_CUDA)
+            return "cuda";
+#else
+            return "";
+#endif
+        }
+    } // namespace _impl
+
+    /**
+     * The fixture of the regression tests. The benchmark functions run the computation `s_steps` times after a first
+     * run. By default the caches are flushed before every run (`--warm-cache` disables it). The statistics of the
+     * times of the runs are printed and written to the JSON file given by `--json=`, in the format of
+     * pyutils/perftest/result.py.
+     */
     template <size_t HaloSize = 0, class Axis = axis<1>>
     class regression_fixture : public computation_fixture<HaloSize, Axis>, _impl::regression_fixture_base {
       public:
@@ -29,21 +56,100 @@ namespace gridtools {
                 computation_fixture<HaloSize, Axis>::verify(wstd::forward<Args>(args)...);
         }
 
+        /**
+         * The floating point operations and the bytes loaded and stored per computed grid point, from which the
+         * benchmarks derive the achieved performance. Halo points are not counted, zero values are not known.
+         */
+        struct point_model {
+            double flops;
+            double bytes;
+        };
+
+        static point_model flops_per_point(double flops) { return {flops, 0}; }
+        static point_model bytes_per_point(double bytes) { return {0, bytes}; }
+
+        /**
+         * Runs the computation `s_steps` times and prints its meter and the average wall time of a run. The achieved
+         * bandwidth (also relative to the STREAM bandwidth, see `stream_bandwidth`) and floating point performance are
+         * reported as well if they are known, either from the given model or else from the traffic model of the
+         * computation (see `computation::get_traffic_model`).
+         */
         template <class Comp>
-        void benchmark(Comp &&comp) const {
+        void benchmark(Comp &&comp, point_model model = {}) const {
             if (s_steps == 0)
                 return;
-            // we run a first time the stencil, since if there is data allocation before by other codes, the first run
-            // of the stencil is very slow (we dont know why). The flusher should make sure we flush the cache
+            double seconds = timed_runs(comp);
+            std::cout << comp.print_meter() << std::endl;
+            double bytes = 0, flops = 0;
+            get_traffic_model(comp, bytes, flops, 0);
+            if (model.bytes > 0)
+                bytes = model.bytes * points();
+            if (model.flops > 0)
+                flops = model.flops * points();
+            report(seconds, bytes, flops);
+        }
+
+      private:
+        template <class Comp>
+        auto get_traffic_model(Comp const &comp, double &bytes, double &flops, int) const
+            -> decltype(comp.get_traffic_model(), void()) {
+            auto model = comp.get_traffic_model();
+            bytes = model.bytes();
+            if (model.has_flops)
+                flops = model.flops;
+        }
+
+        template <class Comp>
+        void get_traffic_model(Comp const &, double &, double &, long) const {}
+
+        /**
+         * Prints the performance achieved by `s_steps` runs in `seconds`, given the bytes and the floating point
+         * operations of a run. Zero values are not reported.
+         */
+        void report(double seconds, double bytes, double flops) const {
+            std::cout << "us/run: " << seconds / s_steps * 1e6 << std::endl;
+            if (bytes > 0) {
+                double bandwidth = bytes * s_steps / seconds * 1e-9;
+                std::cout << "GB/s: " << bandwidth << std::endl;
+#ifdef __CUDACC__
+                double stream = stream_bandwidth(false);
+#else
+                double stream = stream_bandwidth(true);
+#endif
+                if (stream > 0)
+                    std::cout << "% of STREAM: " << 100 * bandwidth / stream << std::endl;
+            }
+            if (flops > 0)
+                std::cout << "GFlop/s: " << flops * s_steps / seconds * 1e-9 << std::endl;
+        }
+
+        double points() const { return double(this->d1() - 2 * HaloSize) * (this->d2() - 2 * HaloSize) * this->d3(); }
+
+        template <class Comp>
+        double timed_runs(Comp &comp) const {
             comp.run();
             comp.reset_meter();
+            std::vector<double> times;
+            times.reserve(s_steps);
             for (size_t i = 0; i != s_steps; ++i) {
 #ifndef __CUDACC__
-                flush_cache();
+                if (!s_warm_cache)
+                    flush_cache();
 #endif
+                auto start = std::chrono::high_resolution_clock::now();
                 comp.run();
+#ifdef __CUDACC__
+                GT_CUDA_CHECK(cudaDeviceSynchronize());
+#endif
+                times.push_back(
+                    std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count());
             }
-            std::cout << comp.print_meter() << std::endl;
+            report_times(
+                times, HaloSize, _impl::regression_backend_name(), sizeof(float_type) == 4 ? "float" : "double");
+            double seconds = 0;
+            for (double time : times)
+                seconds += time;
+            return seconds;
         }
     };
 } // namespace gridtools
@@ -9,6 +9,9 @@
  */
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "../common/defs.hpp"
 
 namespace gridtools {
@@ -20,11 +23,35 @@ namespace gridtools {
             static uint_t s_d3;
             static uint_t s_steps;
             static bool s_needs_verification;
+            static bool s_warm_cache;
+            static bool s_pin_threads;
+            static std::string s_json_file;
 
             static void flush_cache();
 
+            /**
+             * The memory bandwidth [GB/s] the achieved bandwidth of the benchmarks is compared to: the value of the
+             * GT_STREAM_BANDWIDTH environment variable if it is set, otherwise the bandwidth of a STREAM triad on the
+             * host, measured on the first call, if `measure` is true and zero if it is false.
+             */
+            static double stream_bandwidth(bool measure);
+
+            /**
+             * Prints the statistics of the times [s] of the runs of a benchmark (median, percentiles, mean and their
+             * 95% confidence intervals) and records them for the JSON output, under the name of the current test.
+             * `halo` is the halo size of the fixture, `backend` and `precision` describe the build in the JSON output.
+             */
+            static void report_times(
+                std::vector<double> const &times, uint_t halo, char const *backend, char const *precision);
+
+            /// Pins the OpenMP threads to the CPUs the process may run on, one CPU per thread (Linux only).
+            static void pin_threads();
+
           public:
             static void init(int argc, char **argv);
+
+            /// Writes the times recorded by `report_times` to the file given by `--json=`, if any.
+            static void write_json();
         };
     } // namespace _impl
 } // namespace gridtools
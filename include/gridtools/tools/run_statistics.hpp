@@ -0,0 +1,88 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace gridtools {
+
+    /**
+     * Statistics of the times of repeated runs of a benchmark.
+     *
+     * The percentiles are interpolated linearly between the sorted samples (like numpy.percentile). The 95%
+     * confidence interval of the median is given by the order statistics whose (1-based) ranks are
+     * floor((n - 1.96 sqrt(n)) / 2) and ceil(1 + (n + 1.96 sqrt(n)) / 2), which does not assume a distribution of the
+     * times. The one of the mean uses the normal approximation.
+     */
+    struct run_statistics {
+        std::size_t count = 0;
+        double min = 0;
+        double max = 0;
+        double mean = 0;
+        double stddev = 0;
+        double mean_ci_low = 0;
+        double mean_ci_high = 0;
+        double median = 0;
+        double median_ci_low = 0;
+        double median_ci_high = 0;
+        double p05 = 0;
+        double p25 = 0;
+        double p75 = 0;
+        double p95 = 0;
+    };
+
+    namespace run_statistics_impl_ {
+        inline double percentile(std::vector<double> const &sorted, double q) {
+            double pos = q / 100 * (sorted.size() - 1);
+            std::size_t lower = static_cast<std::size_t>(pos);
+            if (lower + 1 >= sorted.size())
+                return sorted.back();
+            return sorted[lower] + (pos - lower) * (sorted[lower + 1] - sorted[lower]);
+        }
+    } // namespace run_statistics_impl_
+
+    inline run_statistics compute_run_statistics(std::vector<double> times) {
+        assert(!times.empty());
+        using run_statistics_impl_::percentile;
+        std::sort(times.begin(), times.end());
+        run_statistics res;
+        std::size_t n = times.size();
+        res.count = n;
+        res.min = times.front();
+        res.max = times.back();
+        double sum = 0;
+        for (double t : times)
+            sum += t;
+        res.mean = sum / n;
+        double sum_of_squares = 0;
+        for (double t : times)
+            sum_of_squares += (t - res.mean) * (t - res.mean);
+        res.stddev = n > 1 ? std::sqrt(sum_of_squares / (n - 1)) : 0;
+        double mean_error = 1.96 * res.stddev / std::sqrt(double(n));
+        res.mean_ci_low = res.mean - mean_error;
+        res.mean_ci_high = res.mean + mean_error;
+        res.median = percentile(times, 50);
+        double rank_error = 1.96 * std::sqrt(double(n)) / 2;
+        // 0-based ranks of the bounds of the confidence interval of the median
+        double low = std::floor(n / 2. - rank_error) - 1;
+        double high = std::ceil(n / 2. + rank_error);
+        res.median_ci_low = times[low < 0 ? 0 : std::size_t(low)];
+        res.median_ci_high = times[high > n - 1 ? n - 1 : std::size_t(high)];
+        res.p05 = percentile(times, 5);
+        res.p25 = percentile(times, 25);
+        res.p75 = percentile(times, 75);
+        res.p95 = percentile(times, 95);
+        return res;
+    }
+} // namespace gridtools
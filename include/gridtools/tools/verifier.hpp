@@ -15,8 +15,6 @@
 #include "../common/array.hpp"
 #include "../common/array_addons.hpp"
 #include "../common/gt_math.hpp"
-#include "../common/hypercube_iterator.hpp"
-#include "../common/tuple_util.hpp"
 #include "../meta/type_traits.hpp"
 #include "../storage/common/storage_info_rt.hpp"
 #include "../storage/storage_facility.hpp"
@@ -55,6 +53,80 @@ namespace gridtools {
         return actual == expected;
     }
 
+    /**
+     * The outcome of a comparison of two fields: the number of compared points, the number of errors and the norms of
+     * the absolute differences.
+     */
+    struct verification_result {
+        size_t points = 0;
+        size_t error_count = 0;
+        double max_error = 0;
+        double rms_error = 0;
+
+        bool passed() const { return error_count == 0; }
+
+        friend std::ostream &operator<<(std::ostream &out, verification_result const &res) {
+            return out << res.error_count << " errors out of " << res.points << " points, max error: " << res.max_error
+                       << ", RMS error: " << res.rms_error;
+        }
+    };
+
+    namespace impl_ {
+        template <class T, enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+        GT_FUNCTION double abs_error(T const &expected, T const &actual) {
+            return math::fabs(static_cast<double>(expected) - static_cast<double>(actual));
+        }
+
+        // the norms of the errors are not defined for other types
+        template <class T, enable_if_t<!std::is_arithmetic<T>::value, int> = 0>
+        GT_FUNCTION double abs_error(T const &, T const &) {
+            return 0;
+        }
+
+        /**
+         * The lines of contiguous elements that cover the box given by `bounds`: the innermost dimension is the one
+         * with the smallest non zero stride, the others are flattened into the line number.
+         */
+        template <size_t N>
+        class verification_lines {
+            array<array<size_t, 2>, N> m_bounds;
+            size_t m_inner = 0;
+            size_t m_count = 1;
+
+          public:
+            template <class Strides>
+            verification_lines(array<array<size_t, 2>, N> const &bounds, Strides const &strides) : m_bounds(bounds) {
+                for (size_t d = 0; d != N; ++d)
+                    if (strides[d] != 0 && (strides[m_inner] == 0 || strides[d] < strides[m_inner]))
+                        m_inner = d;
+                for (size_t d = 0; d != N; ++d)
+                    if (d != m_inner)
+                        m_count *= m_bounds[d][1] > m_bounds[d][0] ? m_bounds[d][1] - m_bounds[d][0] : 0;
+                if (m_bounds[m_inner][1] <= m_bounds[m_inner][0])
+                    m_count = 0;
+            }
+
+            size_t count() const { return m_count; }
+            size_t inner() const { return m_inner; }
+            size_t length() const { return m_count == 0 ? 0 : m_bounds[m_inner][1] - m_bounds[m_inner][0]; }
+
+            /// the position of the first element of the given line
+            array<int, N> first(size_t line) const {
+                array<int, N> res;
+                for (size_t d = N; d-- != 0;) {
+                    if (d == m_inner) {
+                        res[d] = m_bounds[d][0];
+                        continue;
+                    }
+                    size_t extent = m_bounds[d][1] - m_bounds[d][0];
+                    res[d] = m_bounds[d][0] + line % extent;
+                    line /= extent;
+                }
+                return res;
+            }
+        };
+    } // namespace impl_
+
     class verifier {
         double m_precision;
         size_t m_max_error;
@@ -62,40 +134,100 @@ namespace gridtools {
       public:
         verifier(double precision, size_t max_error = 20) : m_precision(precision), m_max_error(max_error) {}
 
+        /**
+         * Compares the fields on the box given by the halos, the fields should have the same sizes. The lines of
+         * contiguous elements are compared in parallel by the OpenMP threads, the error count and the norms of the
+         * differences are reduced over them. The first `max_error` errors are printed.
+         */
         template <typename Grid, typename StorageType>
-        bool verify(Grid const & /*TODO: unused*/,
+        verification_result compare(Grid const & /*TODO: unused*/,
             StorageType const &expected_field,
             StorageType const &actual_field,
-            array<array<uint_t, 2>, StorageType::storage_info_t::layout_t::masked_length> halos = {}) {
+            array<array<uint_t, 2>, StorageType::storage_info_t::layout_t::masked_length> halos = {}) const {
+            constexpr size_t ndims = StorageType::storage_info_t::layout_t::masked_length;
             // TODO This is following the original implementation. Shouldn't we deduce the range from the grid (as we
             // already pass it)?
             storage_info_rt meta_rt = make_storage_info_rt(*(expected_field.get_storage_info_ptr()));
-            array<array<size_t, 2>, StorageType::storage_info_t::layout_t::masked_length> bounds;
+            storage_info_rt actual_meta_rt = make_storage_info_rt(*(actual_field.get_storage_info_ptr()));
+            array<array<size_t, 2>, ndims> bounds;
             for (size_t i = 0; i < bounds.size(); ++i) {
                 bounds[i] = {halos[i][0], meta_rt.total_lengths()[i] - halos[i][1]};
             }
-            auto cube_view = make_hypercube_view(bounds);
+            impl_::verification_lines<ndims> lines(bounds, meta_rt.strides());
+            size_t length = lines.length();
+            ptrdiff_t expected_stride = meta_rt.strides()[lines.inner()];
+            ptrdiff_t actual_stride = actual_meta_rt.strides()[lines.inner()];
 
             expected_field.sync();
             auto expected_view = make_host_view<access_mode::read_only>(expected_field);
             actual_field.sync();
             auto actual_view = make_host_view<access_mode::read_only>(actual_field);
 
+            double precision = m_precision;
+            size_t error_count = 0;
+            double max_error = 0;
+            double sum_of_squares = 0;
+#pragma omp parallel for reduction(+ : error_count, sum_of_squares) reduction(max : max_error)
+            for (size_t line = 0; line < lines.count(); ++line) {
+                auto first = lines.first(line);
+                auto const *expected = &expected_view(first);
+                auto const *actual = &actual_view(first);
+#pragma omp simd reduction(+ : error_count, sum_of_squares) reduction(max : max_error)
+                for (size_t i = 0; i < length; ++i) {
+                    auto e = expected[i * expected_stride];
+                    auto a = actual[i * actual_stride];
+                    double error = impl_::abs_error(e, a);
+                    error_count += !expect_with_threshold(e, a, precision);
+                    max_error = error > max_error ? error : max_error;
+                    sum_of_squares += error * error;
+                }
+            }
+
+            verification_result res;
+            res.points = lines.count() * length;
+            res.error_count = error_count;
+            res.max_error = max_error;
+            res.rms_error = res.points == 0 ? 0 : math::sqrt(sum_of_squares / res.points);
+            if (error_count != 0)
+                print_errors(lines, expected_view, actual_view);
+            return res;
+        }
+
+        /**
+         * Compares the fields like `compare` and returns true if they match. On failure the error norms are printed.
+         */
+        template <typename Grid, typename StorageType>
+        bool verify(Grid const &grid,
+            StorageType const &expected_field,
+            StorageType const &actual_field,
+            array<array<uint_t, 2>, StorageType::storage_info_t::layout_t::masked_length> halos = {}) const {
+            verification_result res = compare(grid, expected_field, actual_field, halos);
+            if (!res.passed())
+                std::cout << res << std::endl;
+            return res.passed();
+        }
+
+      private:
+        // prints the first errors in order, this is only done if there are errors
+        template <class Lines, class View>
+        void print_errors(Lines const &lines, View const &expected_view, View const &actual_view) const {
             size_t error_count = 0;
-            for (auto &&pos : cube_view) {
-                auto expected = expected_view(tuple_util::convert_to<array, int>(pos));
-                auto actual = actual_view(tuple_util::convert_to<array, int>(pos));
-                if (!expect_with_threshold(expected, actual, m_precision)) {
-                    if (error_count < m_max_error)
-                        std::cout << "Error in position " << pos << " ; expected : " << expected
-                                  << " ; actual : " << actual << "\n";
-                    error_count++;
+            for (size_t line = 0; line < lines.count(); ++line) {
+                auto pos = lines.first(line);
+                for (size_t i = 0; i < lines.length(); ++i, ++pos[lines.inner()]) {
+                    auto expected = expected_view(pos);
+                    auto actual = actual_view(pos);
+                    if (!expect_with_threshold(expected, actual, m_precision)) {
+                        if (error_count < m_max_error)
+                            std::cout << "Error in position " << pos << " ; expected : " << expected
+                                      << " ; actual : " << actual << "\n";
+                        error_count++;
+                    }
                 }
             }
             if (error_count > m_max_error)
                 std::cout << "Displayed the first " << m_max_error << " errors, " << error_count - m_max_error
                           << " skipped!" << std::endl;
-            return error_count == 0;
         }
     };
 
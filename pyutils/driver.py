@@ -100,6 +100,23 @@ if buildinfo:
                                  result)
 
 
+@perftest.command(description='check for performance regressions')
+@args.arg('--reference', '-r', required=True, help='reference result file')
+@args.arg('--input', '-i', required=True, help='result file to check')
+@args.arg('--threshold', '-t', type=float, default=0.05,
+          help='tolerated relative slowdown of the median run time')
+def check(reference, input, threshold):
+    from perftest import result
+    found = result.regressions(result.load(reference), result.load(input),
+                               threshold)
+    for r in found:
+        log.error(f'{r.stencil}: median {r.current:.3e}s, reference '
+                  f'{r.reference:.3e}s ({r.change:+.1%})')
+    if found:
+        raise RuntimeError(f'Found {len(found)} performance regressions')
+    log.info('No performance regressions found')
+
+
 @perftest.command(description='plot performance results')
 def plot():
     pass
@@ -142,8 +142,9 @@ def load(filename):
     elif data['version'] != version:
         raise ValueError(f'Unknown result file version "{data["version"]}"')
 
-    times_data = [Data(stencil=d['stencil'], measurements=d['measurements'])
-                  for d in data['times']]
+    # additional keys (e.g. `statistics` and `cache` written by the C++
+    # regression benchmarks) are kept as they are
+    times_data = [Data(d) for d in data['times']]
 
     result = Result(runinfo=runinfo_data,
                     times=times_data,
@@ -154,6 +155,27 @@ def load(filename):
     return result
 
 
+def load_stage_meters(filename):
+    """Loads the per stage meters written by the C++ `stage_meters::to_json`.
+
+    Args:
+        filename: The name of the input json file.
+
+    Returns:
+        A list of `Data` objects, one per stage, with the totals over all
+        threads (`stage`, `time`, `count`, `cycles`, `llc_misses`,
+        `llc_miss_bytes`) and the per thread records in `threads`. The
+        counters are None if they were not available.
+    """
+    with open(filename, 'r') as fp:
+        data = json.load(fp)
+
+    stages = [Data(d, threads=[Data(t) for t in d['threads']])
+              for d in data['stages']]
+    log.info(f'Successfully loaded stage meters from {filename}')
+    return stages
+
+
 def by_stencils(results_data):
     return list(zip(*results_data))
 
@@ -219,6 +241,56 @@ def percentiles_by_stencil(results, percentiles):
     return (stencils, *qtimes)
 
 
+def _median_ci(times):
+    """Median and its 95% confidence interval from order statistics."""
+    times = sorted(times)
+    n = len(times)
+    half = 1.96 * np.sqrt(n) / 2
+    low = max(int(np.floor(n / 2 - half)) - 1, 0)
+    high = min(int(np.ceil(n / 2 + half)), n - 1)
+    return np.median(times), times[low], times[high]
+
+
+def _median_and_ci(t):
+    if 'statistics' in t:
+        s = t.statistics
+        return s['median'], s['median_ci'][0], s['median_ci'][1]
+    return _median_ci(t.measurements)
+
+
+def regressions(reference, current, threshold=0.05):
+    """Detects the stencils that got slower between two results.
+
+    A stencil is a regression if its median run time in `current` exceeds the
+    one in `reference` by more than `threshold` (relative) and the 95%
+    confidence intervals of the medians do not overlap. The statistics
+    written by the C++ benchmarks are used if available, otherwise they are
+    computed from the measurements.
+
+    Args:
+        reference: The reference `Result`.
+        current: The `Result` to check.
+        threshold: The relative slowdown that is tolerated.
+
+    Returns:
+        A list of `Data` objects (`stencil`, `reference`, `current`,
+        `change`) with the medians and the relative change, one per
+        regression. Stencils that are missing in either result are ignored.
+    """
+    reference_times = {t.stencil: t for t in reference.times}
+    res = []
+    for t in current.times:
+        if t.stencil not in reference_times:
+            continue
+        ref, _, ref_high = _median_and_ci(reference_times[t.stencil])
+        cur, cur_low, _ = _median_and_ci(t)
+        change = cur / ref - 1
+        if change > threshold and cur_low > ref_high:
+            res.append(Data(stencil=t.stencil, reference=ref, current=cur,
+                            change=change))
+    return res
+
+
 def compare(results):
     """Compares multiple results and splits equal and unequal parts.
 
@@ -60,3 +60,32 @@ TEST_F(advection_pdbott_prepare_tracers, test) {
 
     benchmark(comp);
 }
+
+TEST_F(advection_pdbott_prepare_tracers, host_overhead) {
+    using storages_t = std::vector<storage_type>;
+
+    arg<0, storages_t> p_out;
+    arg<1, storages_t> p_in;
+    arg<2, storage_type> p_rho;
+
+    storages_t in, out;
+
+    for (size_t i = 0; i < 80; ++i) {
+        out.push_back(make_storage());
+        in.push_back(make_storage(1. * i));
+    }
+
+    auto comp = gridtools::make_expandable_computation<backend_t>(expand_factor<6>(),
+        make_grid(),
+        p_out = out,
+        p_in = in,
+        p_rho = make_storage(1.1),
+        make_multistage(execute::forward(), make_stage<prepare_tracers>(p_out, p_in, p_rho)));
+
+    comp.run();
+    for (size_t i = 0; i != out.size(); ++i)
+        verify(make_storage([i](int_t, int_t, int_t) { return 1.1 * i; }), out[i]);
+
+    // the storages are the same for every run, so the local domains are built by the first run only
+    benchmark(comp);
+}
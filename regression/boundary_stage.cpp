@@ -0,0 +1,121 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/boundary_conditions/boundary.hpp>
+#include <gridtools/boundary_conditions/copy.hpp>
+#include <gridtools/boundary_conditions/value.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+/**
+  @file
+  Compares a computation with a boundary condition attached as a final stage (`make_boundary_stage`), which the
+  backend applies next to every block while it is still in cache, with the same computation followed by a separate
+  `boundary` pass over the halo.
+*/
+
+using namespace gridtools;
+
+namespace {
+    struct copy_functor {
+        using in = in_accessor<0>;
+        using out = inout_accessor<1>;
+
+        using param_list = make_param_list<in, out>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = eval(in());
+        }
+    };
+
+    template <class F>
+    struct sweep {
+        F m_f;
+        std::string m_name;
+
+        void run() { m_f(); }
+        std::string print_meter() const { return m_name; }
+        void reset_meter() {}
+    };
+
+    template <class F>
+    sweep<F> make_sweep(F f, std::string name) {
+        return {f, name};
+    }
+} // namespace
+
+struct boundary_stage_fixture : regression_fixture<3> {
+    storage_type in = make_storage([](int i, int j, int k) { return i + 10 * j + 100 * k; });
+
+    // the i-j halo of the grid, the boundary stages are not applied in the k direction
+    array<halo_descriptor, 3> boundary_halos() const {
+        return {i_halo_descriptor(), j_halo_descriptor(), halo_descriptor(0, 0, 0, d3() - 1, d3())};
+    }
+
+    template <class... Stages>
+    auto make_copy(storage_type &out, Stages const &... stages)
+        GT_AUTO_RETURN(make_computation(p_0 = in,
+            p_1 = out,
+            make_multistage(execute::parallel(), make_stage<copy_functor>(p_0, p_1)),
+            stages...));
+
+    // the halo points are compared as well
+    void verify_all(storage_type const &expected, storage_type const &actual) const {
+        EXPECT_TRUE(verifier(1e-10).compare(make_grid(), expected, actual).passed());
+    }
+};
+
+TEST_F(boundary_stage_fixture, copy) {
+    auto out = make_storage(-1.), expected = make_storage(-1.);
+
+    auto separate = make_copy(expected);
+    boundary<copy_boundary, backend_t> separate_boundary(boundary_halos(), copy_boundary());
+    auto fused = make_copy(out, make_boundary_stage(copy_boundary(), p_1, p_0));
+
+    separate.run();
+    separate_boundary.apply(expected, in);
+    fused.run();
+    verify_all(expected, out);
+    verify_all(in, out);
+
+    benchmark(make_sweep(
+        [&] {
+            separate.run();
+            separate_boundary.apply(expected, in);
+        },
+        "separate"));
+    benchmark(make_sweep([&] { fused.run(); }, "fused"));
+}
+
+TEST_F(boundary_stage_fixture, value) {
+    auto out = make_storage(-1.), expected = make_storage(-1.);
+
+    auto separate = make_copy(expected);
+    boundary<value_boundary<float_type>, backend_t> separate_boundary(boundary_halos(), value_boundary<float_type>(3));
+    auto fused = make_copy(out, make_boundary_stage(value_boundary<float_type>(3), p_1));
+
+    separate.run();
+    separate_boundary.apply(expected);
+    fused.run();
+    verify_all(expected, out);
+
+    benchmark(make_sweep(
+        [&] {
+            separate.run();
+            separate_boundary.apply(expected);
+        },
+        "separate"));
+    benchmark(make_sweep([&] { fused.run(); }, "fused"));
+}
@@ -0,0 +1,111 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/boundary_conditions/boundary.hpp>
+#include <gridtools/boundary_conditions/copy.hpp>
+#include <gridtools/boundary_conditions/value.hpp>
+#include <gridtools/boundary_conditions/zero.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+/**
+  @file
+  Compares the boundary application in a single parallel sweep over the halo regions of all directions
+  (`boundary::apply_in_single_sweep`) with the default application, which runs one parallel loop per direction.
+*/
+
+using namespace gridtools;
+
+namespace {
+    template <class F>
+    struct sweep {
+        F m_f;
+        std::string m_name;
+
+        void run() { m_f(); }
+        std::string print_meter() const { return m_name; }
+        void reset_meter() {}
+    };
+
+    template <class F>
+    sweep<F> make_sweep(F f, std::string name) {
+        return {f, name};
+    }
+} // namespace
+
+struct boundary_sweep : regression_fixture<3> {
+    storage_type in = make_storage([](int i, int j, int k) { return i + 10 * j + 100 * k; });
+
+    array<halo_descriptor, 3> boundary_halos() const {
+        return {halo_descriptor(3, 3, 3, d1() - 4, d1()),
+            halo_descriptor(3, 3, 3, d2() - 4, d2()),
+            halo_descriptor(1, 1, 1, d3() - 2, d3())};
+    }
+
+    template <class BoundaryFunction, class... Fields>
+    void apply_fused(BoundaryFunction const &boundary_function, Fields &... fields) const {
+        boundary<BoundaryFunction, backend_t>(boundary_halos(), boundary_function).apply_in_single_sweep(fields...);
+    }
+
+    template <class BoundaryFunction, class... Fields>
+    void apply_per_direction(BoundaryFunction const &boundary_function, Fields &... fields) const {
+        boundary<BoundaryFunction, backend_t>(boundary_halos(), boundary_function).apply(fields...);
+    }
+
+    // the halo points are compared as well
+    void verify_all(storage_type const &expected, storage_type const &actual) const {
+        EXPECT_TRUE(verifier(1e-10).compare(make_grid(), expected, actual).passed());
+    }
+};
+
+TEST_F(boundary_sweep, copy) {
+    auto out0 = make_storage(-1.), out1 = make_storage(-1.);
+    auto expected0 = make_storage(-1.), expected1 = make_storage(-1.);
+
+    apply_per_direction(copy_boundary(), expected0, expected1, in);
+    apply_fused(copy_boundary(), out0, out1, in);
+    verify_all(expected0, out0);
+    verify_all(expected1, out1);
+
+    benchmark(make_sweep([&] { apply_per_direction(copy_boundary(), out0, out1, in); }, "per direction"));
+    benchmark(make_sweep([&] { apply_fused(copy_boundary(), out0, out1, in); }, "fused"));
+}
+
+TEST_F(boundary_sweep, value) {
+    auto out0 = make_storage(-1.), out1 = make_storage(-1.), out2 = make_storage(-1.);
+    auto expected0 = make_storage(-1.);
+
+    apply_per_direction(value_boundary<float_type>(3), expected0);
+    apply_fused(value_boundary<float_type>(3), out0, out1, out2);
+    verify_all(expected0, out0);
+    verify_all(expected0, out1);
+    verify_all(expected0, out2);
+
+    benchmark(make_sweep(
+        [&] { apply_per_direction(value_boundary<float_type>(3), out0, out1, out2); }, "per direction"));
+    benchmark(make_sweep([&] { apply_fused(value_boundary<float_type>(3), out0, out1, out2); }, "fused"));
+}
+
+TEST_F(boundary_sweep, zero) {
+    auto out0 = make_storage([](int i, int j, int k) { return i + j + k; });
+    auto out1 = make_storage([](int i, int j, int k) { return i + j + k; });
+    auto expected0 = make_storage([](int i, int j, int k) { return i + j + k; });
+
+    apply_per_direction(zero_boundary(), expected0);
+    apply_fused(zero_boundary(), out0, out1);
+    verify_all(expected0, out0);
+    verify_all(expected0, out1);
+
+    benchmark(make_sweep([&] { apply_per_direction(zero_boundary(), out0, out1); }, "per direction"));
+    benchmark(make_sweep([&] { apply_fused(zero_boundary(), out0, out1); }, "fused"));
+}
@@ -0,0 +1,151 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <iomanip>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+#include <mpi.h>
+
+#include "gtest/gtest.h"
+
+#include <gridtools/common/boollist.hpp>
+#include <gridtools/communication/halo_exchange.hpp>
+
+/**
+  @file
+  Latency microbenchmark of the halo exchange: many exchanges of a small field, where the cost is dominated by the
+  posting and completion of the messages, with regular and with persistent MPI requests, and with persistent
+  requests and the faces unpacked as they arrive.
+*/
+
+namespace halo_exchange_latency {
+    typedef gridtools::halo_exchange_dynamic_ut<gridtools::layout_map<0, 1, 2>,
+        gridtools::layout_map<0, 1, 2>,
+        double,
+        gridtools::gcl_cpu>
+        pattern_type;
+
+    struct result {
+        double m_time_per_exchange; // in microseconds, maximum over the processes
+        int m_errors;               // sum over the processes
+    };
+
+    /**
+       Runs `iterations` exchanges of a field with `size` inner points and a halo of width `halo` in each dimension,
+       with the value of each point given by its global coordinates and by the iteration.
+    */
+    result run(bool persistent, bool unpack_on_arrival, int iterations, int size, int halo) {
+        int nprocs;
+        MPI_Comm_size(gridtools::GCL_WORLD, &nprocs);
+        int dims[3] = {0, 0, 0};
+        MPI_Dims_create(nprocs, 3, dims);
+        int period[3] = {1, 1, 1};
+        MPI_Comm comm;
+        MPI_Cart_create(gridtools::GCL_WORLD, 3, dims, period, false, &comm);
+        int coords[3];
+        MPI_Cart_get(comm, 3, dims, period, coords);
+
+        pattern_type he(pattern_type::grid_type::period_type(true, true, true), comm);
+        he.set_persistent_requests(persistent);
+        he.set_unpack_on_arrival(unpack_on_arrival);
+        he.add_halo<0>(halo, halo, halo, size + halo - 1, size + 2 * halo);
+        he.add_halo<1>(halo, halo, halo, size + halo - 1, size + 2 * halo);
+        he.add_halo<2>(halo, halo, halo, size + halo - 1, size + 2 * halo);
+        he.setup(1);
+
+        const int total = size + 2 * halo;
+        std::vector<double> field(total * total * total);
+        auto global = [&](int d, int i) { return (i - halo + size * coords[d] + size * dims[d]) % (size * dims[d]); };
+        auto value = [&](int i, int j, int k, int iteration) {
+            return iteration + 1e3 * global(0, i) + 1e6 * global(1, j) + 1e9 * global(2, k);
+        };
+        auto at = [&](int i, int j, int k) -> double & { return field[(i * total + j) * total + k]; };
+        auto init = [&](int iteration) {
+            for (int i = halo; i < size + halo; ++i)
+                for (int j = halo; j < size + halo; ++j)
+                    for (int k = halo; k < size + halo; ++k)
+                        at(i, j, k) = value(i, j, k, iteration);
+        };
+
+        // a first exchange, which initializes the persistent requests, is not timed
+        init(0);
+        he.pack(field.data());
+        he.exchange();
+        he.unpack(field.data());
+
+        MPI_Barrier(comm);
+        double start = MPI_Wtime();
+        for (int iteration = 1; iteration <= iterations; ++iteration) {
+            init(iteration);
+            he.post_receives();
+            he.pack(field.data());
+            he.do_sends();
+            he.wait();
+            he.unpack(field.data());
+        }
+        double time = (MPI_Wtime() - start) / iterations * 1e6;
+
+        int errors = 0;
+        for (int i = 0; i < total; ++i)
+            for (int j = 0; j < total; ++j)
+                for (int k = 0; k < total; ++k)
+                    errors += at(i, j, k) != value(i, j, k, iterations);
+
+        result res;
+        MPI_Allreduce(&time, &res.m_time_per_exchange, 1, MPI_DOUBLE, MPI_MAX, comm);
+        MPI_Allreduce(&errors, &res.m_errors, 1, MPI_INT, MPI_SUM, comm);
+        MPI_Comm_free(&comm);
+        return res;
+    }
+
+    bool test(int iterations, int size, int halo) {
+        int pid;
+        MPI_Comm_rank(gridtools::GCL_WORLD, &pid);
+
+        struct variant {
+            char const *m_name;
+            bool m_persistent;
+            bool m_unpack_on_arrival;
+        };
+        bool passed = true;
+        for (variant v : {variant{"regular requests", false, false},
+                 variant{"persistent requests", true, false},
+                 variant{"persistent, unpack on arrival", true, true}}) {
+            result res = run(v.m_persistent, v.m_unpack_on_arrival, iterations, size, halo);
+            if (pid == 0)
+                std::cout << std::left << std::setw(32) << v.m_name << res.m_time_per_exchange << " us per exchange"
+                          << std::endl;
+            passed = passed && res.m_errors == 0;
+        }
+        return passed;
+    }
+} // namespace halo_exchange_latency
+
+#ifdef STANDALONE
+int main(int argc, char **argv) {
+    MPI_Init(&argc, &argv);
+    gridtools::GCL_Init(argc, argv);
+
+    if (argc != 4) {
+        std::cout << "Usage: halo_exchange_latency iterations size halo\n where size is the number of inner points of "
+                     "the field and halo the halo width in each dimension"
+                  << std::endl;
+        return 1;
+    }
+
+    bool passed = halo_exchange_latency::test(atoi(argv[1]), atoi(argv[2]), atoi(argv[3]));
+
+    MPI_Finalize();
+    return passed ? 0 : 1;
+}
+#else
+TEST(Communication, halo_exchange_latency) { EXPECT_TRUE(halo_exchange_latency::test(100, 4, 1)); }
+#endif
@@ -52,3 +52,32 @@ TEST_F(expandable_parameters, test) {
     for (size_t i = 0; i != in.size(); ++i)
         verify(in[i], out[i]);
 }
+
+// Runs the copy for all numbers of tracers up to 64 with an expand factor of 8: the remainder of the division by 8 is
+// processed in at most three sweeps (4 + 2 + 1).
+TEST_F(expandable_parameters, tracer_counts) {
+    using storages_t = std::vector<storage_type>;
+    storages_t out, in;
+
+    arg<0, storages_t> p_out;
+    arg<1, storages_t> p_in;
+
+    for (size_t tracers = 1; tracers <= 64; ++tracers) {
+        in.push_back(make_storage(float_type(tracers)));
+        // fresh outputs, so that the values written by the previous runs are not verified again
+        out.clear();
+        for (size_t i = 0; i != tracers; ++i)
+            out.push_back(make_storage(0.));
+
+        auto comp = gridtools::make_expandable_computation<backend_t>(expand_factor<8>(),
+            make_grid(),
+            p_out = out,
+            p_in = in,
+            make_multistage(execute::parallel(), make_stage<copy_functor>(p_out, p_in)));
+        comp.run();
+        for (size_t i = 0; i != tracers; ++i)
+            verify(in[i], out[i]);
+
+        benchmark(comp, bytes_per_point(2 * tracers * sizeof(float_type)));
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+/**
+  @file
+  Independent diagnostics of the same input field, computed by separate computations one after the other and by the
+  computation obtained from fusing them (see fuse_computations), which reads the input once.
+*/
+
+using namespace gridtools;
+
+struct laplacian_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) =
+            4 * eval(in()) - (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0)));
+    }
+};
+
+struct gradient_i_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<0, 1, 0, 0>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in(1, 0, 0)) - eval(in());
+    }
+};
+
+struct gradient_j_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<0, 0, 0, 1>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in(0, 1, 0)) - eval(in());
+    }
+};
+
+struct fused_diagnostics : regression_fixture<1> {
+    static double in(int i, int j, int k) { return i * i + 2 * j * j + 3 * k; }
+
+    storage_type m_in = make_storage(in);
+    storage_type m_lap = make_storage(-1.);
+    storage_type m_grad_i = make_storage(-1.);
+    storage_type m_grad_j = make_storage(-1.);
+
+    void expect_results() {
+        verify(make_storage([](int i, int j, int k) {
+            return 4 * in(i, j, k) - (in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k));
+        }),
+            m_lap);
+        verify(make_storage([](int i, int j, int k) { return in(i + 1, j, k) - in(i, j, k); }), m_grad_i);
+        verify(make_storage([](int i, int j, int k) { return in(i, j + 1, k) - in(i, j, k); }), m_grad_j);
+    }
+};
+
+// runs the diagnostics one by one
+template <class Lap, class GradI, class GradJ>
+struct run_separately {
+    Lap &m_lap;
+    GradI &m_grad_i;
+    GradJ &m_grad_j;
+    fused_diagnostics::storage_type const &m_in;
+
+    void run() {
+        m_lap.run(fused_diagnostics::p_0 = m_in);
+        m_grad_i.run(fused_diagnostics::p_0 = m_in);
+        m_grad_j.run(fused_diagnostics::p_0 = m_in);
+    }
+    std::string print_meter() const { return "separate computations"; }
+    void reset_meter() {}
+};
+
+template <class Comp>
+struct run_fused {
+    Comp &m_comp;
+    fused_diagnostics::storage_type const &m_in;
+
+    void run() { m_comp.run(fused_diagnostics::p_0 = m_in); }
+    std::string print_meter() const { return m_comp.print_meter(); }
+    void reset_meter() { m_comp.reset_meter(); }
+};
+
+TEST_F(fused_diagnostics, test) {
+    auto lap =
+        make_computation(p_1 = m_lap, make_multistage(execute::parallel(), make_stage<laplacian_functor>(p_1, p_0)));
+    auto grad_i = make_computation(
+        p_2 = m_grad_i, make_multistage(execute::parallel(), make_stage<gradient_i_functor>(p_2, p_0)));
+    auto grad_j = make_computation(
+        p_3 = m_grad_j, make_multistage(execute::parallel(), make_stage<gradient_j_functor>(p_3, p_0)));
+    auto fused = fuse_computations(lap, grad_i, grad_j);
+
+    fused.run(p_0 = m_in);
+    expect_results();
+    benchmark(run_fused<decltype(fused)>{fused, m_in});
+
+    benchmark(run_separately<decltype(lap), decltype(grad_i), decltype(grad_j)>{lap, grad_i, grad_j, m_in});
+}
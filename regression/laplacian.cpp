@@ -7,9 +7,13 @@
  * Please, refer to the LICENSE file in the root directory.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <string>
+#include <utility>
+
 #include <gtest/gtest.h>
 
 #include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/stencil_composition/temporal_blocking.hpp>
 #include <gridtools/tools/regression_fixture.hpp>
 
 using namespace gridtools;
@@ -25,8 +29,45 @@ struct lap {
     }
 };
 
+struct diffusion {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in()) - .1 * (4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) +
+                                                              eval(in(0, -1))));
+    }
+};
+
 using laplacian = regression_fixture<1>;
 
+// runs the time steps of a computation one by one or temporally blocked
+template <class Comp, class Storage>
+struct time_steps {
+    Comp &m_comp;
+    Storage &m_in;
+    Storage &m_out;
+    uint_t m_steps;
+    temporal_blocking m_blocking;
+
+    void run() {
+        if (m_blocking.steps == 0) {
+            for (uint_t t = 0; t != m_steps; ++t) {
+                m_comp.run(laplacian::p_1 = m_in, laplacian::p_0 = m_out);
+                std::swap(m_in, m_out);
+            }
+        } else {
+            run_temporally_blocked(m_comp, m_steps, m_blocking, laplacian::p_1, m_in, laplacian::p_0, m_out);
+        }
+    }
+    std::string print_meter() const {
+        return m_blocking.steps == 0 ? "separate time steps" : "temporally blocked time steps";
+    }
+    void reset_meter() {}
+};
+
 TEST_F(laplacian, test) {
     auto in = [](int_t, int_t, int_t) { return -1.; };
     auto ref = [in](int_t i, int_t j, int_t k) {
@@ -39,3 +80,25 @@ TEST_F(laplacian, test) {
 
     verify(make_storage(ref), out);
 }
+
+TEST_F(laplacian, temporal_blocking) {
+    auto initial = [](int_t i, int_t j, int_t k) { return (i * 7 + j * 13 + k * 5) % 11; };
+    auto comp = make_computation(make_multistage(execute::parallel(), make_stage<diffusion>(p_0, p_1)));
+    using steps_t = time_steps<decltype(comp), storage_type>;
+
+    auto expected_in = make_storage(initial);
+    auto expected_out = make_storage(initial);
+    steps_t separate{comp, expected_in, expected_out, 8, {0, 0, 0}};
+    separate.run();
+
+    auto in = make_storage(initial);
+    auto out = make_storage(initial);
+    steps_t blocked{comp, in, out, 8, {4, 64, 16}};
+    blocked.run();
+
+    verify(expected_in, in);
+    verify(expected_out, out);
+
+    benchmark(separate);
+    benchmark(blocked);
+}
@@ -0,0 +1,138 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+/**
+  @file
+  Measures the time of a run of small computations, to be used with small domains (e.g. 16 16 60) where the fixed
+  cost of a run is comparable with the computation itself. The usual `run` that sets up the storages every time is
+  compared with `run_prepared`, and a sequence of computations run one by one with the same sequence run in a single
+  parallel region (see computation_sequence).
+*/
+
+using namespace gridtools;
+
+struct copy_functor {
+    using in = in_accessor<0>;
+    using out = inout_accessor<1>;
+
+    using param_list = make_param_list<in, out>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in());
+    }
+};
+
+// runs prepared computations one by one
+struct run_each {
+    std::vector<computation<>> &m_comps;
+
+    void run() {
+        for (auto &comp : m_comps)
+            comp.run_prepared();
+    }
+    std::string print_meter() const { return "each computation on its own"; }
+    void reset_meter() {}
+};
+
+struct run_sequence {
+    computation_sequence &m_sequence;
+
+    void run() { m_sequence.run(); }
+    std::string print_meter() const { return "computation sequence"; }
+    void reset_meter() {}
+};
+
+struct launch_overhead : regression_fixture<> {
+    storage_type in = make_storage([](int i, int j, int k) { return i + j + k; });
+    storage_type out = make_storage(-1.);
+
+    // passes the storages to every run
+    template <class Comp>
+    struct run_with_args {
+        Comp &m_comp;
+        launch_overhead const &m_fixture;
+
+        void run() { m_comp.run(p_0 = m_fixture.in, p_1 = m_fixture.out); }
+        std::string print_meter() const { return m_comp.print_meter(); }
+        void reset_meter() { m_comp.reset_meter(); }
+    };
+
+    // runs on the storages bound by prepare
+    template <class Comp>
+    struct run_prepared {
+        Comp &m_comp;
+
+        void run() { m_comp.run_prepared(); }
+        std::string print_meter() const { return m_comp.print_meter(); }
+        void reset_meter() { m_comp.reset_meter(); }
+    };
+};
+
+TEST_F(launch_overhead, copy) {
+    auto comp = make_computation(make_multistage(execute::parallel(), make_stage<copy_functor>(p_0, p_1)));
+
+    comp.run(p_0 = in, p_1 = out);
+    verify(in, out);
+    benchmark(run_with_args<decltype(comp)>{comp, *this});
+
+    out = make_storage(-1.);
+    comp.prepare(p_0 = in, p_1 = out);
+    comp.run_prepared();
+    verify(in, out);
+    benchmark(run_prepared<decltype(comp)>{comp});
+}
+
+TEST_F(launch_overhead, copy_with_temporary) {
+    auto comp = make_computation(make_multistage(execute::forward(),
+        make_stage<copy_functor>(p_0, p_tmp_0),
+        make_stage<copy_functor>(p_tmp_0, p_1)));
+
+    comp.run(p_0 = in, p_1 = out);
+    verify(in, out);
+    benchmark(run_with_args<decltype(comp)>{comp, *this});
+
+    out = make_storage(-1.);
+    comp.prepare(p_0 = in, p_1 = out);
+    comp.run_prepared();
+    verify(in, out);
+    benchmark(run_prepared<decltype(comp)>{comp});
+}
+
+TEST_F(launch_overhead, sequence_of_copies) {
+    // copies back and forth, like a time step made of many small computations
+    std::vector<computation<>> comps;
+    computation_sequence sequence;
+    for (int i = 0; i != 30; ++i) {
+        if (i % 2)
+            comps.push_back(make_computation(
+                p_0 = out, p_1 = in, make_multistage(execute::parallel(), make_stage<copy_functor>(p_0, p_1))));
+        else
+            comps.push_back(make_computation(
+                p_0 = in, p_1 = out, make_multistage(execute::parallel(), make_stage<copy_functor>(p_0, p_1))));
+    }
+    for (auto &comp : comps) {
+        comp.prepare();
+        sequence.add(comp);
+    }
+
+    sequence.run();
+    verify(make_storage([](int i, int j, int k) { return i + j + k; }), out);
+    benchmark(run_each{comps});
+    benchmark(run_sequence{sequence});
+}
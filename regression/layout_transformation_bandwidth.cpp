@@ -0,0 +1,97 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Bandwidth of interface::transform for the conversion of Fortran-ordered fields to the layouts of the CPU backends,
+ * compared to a plain memcpy of the same amount of data.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/interface/layout_transformation/layout_transformation.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+using namespace gridtools;
+
+namespace {
+    // adapts a function to the interface of a computation as expected by regression_fixture::benchmark
+    template <class F>
+    struct timed_function {
+        std::string m_name;
+        F m_f;
+
+        void run() { m_f(); }
+        void reset_meter() {}
+        std::string print_meter() const { return m_name; }
+    };
+
+    template <class F>
+    timed_function<F> make_timed_function(std::string name, F f) {
+        return {std::move(name), std::move(f)};
+    }
+} // namespace
+
+struct layout_transformation_bandwidth : regression_fixture<> {
+    std::vector<float_type> m_src;
+    std::vector<float_type> m_dst;
+
+    layout_transformation_bandwidth() : m_src(size()), m_dst(size()) {
+        for (std::size_t i = 0; i < m_src.size(); ++i)
+            m_src[i] = i;
+    }
+
+    std::size_t size() { return std::size_t(d1()) * d2() * d3(); }
+
+    std::vector<uint_t> dims() { return {d1(), d2(), d3()}; }
+
+    std::vector<uint_t> fortran_strides() { return {1, d1(), d1() * d2()}; }
+
+    void check(std::vector<uint_t> const &dst_strides) {
+        for (uint_t k = 0; k < d3(); ++k)
+            for (uint_t j = 0; j < d2(); ++j)
+                for (uint_t i = 0; i < d1(); ++i)
+                    ASSERT_EQ(m_dst[i * dst_strides[0] + j * dst_strides[1] + k * dst_strides[2]],
+                        m_src[i + j * d1() + k * d1() * d2()]);
+    }
+
+    void run_transform(std::string const &name, std::vector<uint_t> const &dst_strides) {
+        auto dims = this->dims();
+        auto src_strides = fortran_strides();
+        auto comp = make_timed_function(name, [&] {
+            interface::transform(m_dst.data(), m_src.data(), dims, dst_strides, src_strides);
+        });
+        comp.run();
+        check(dst_strides);
+        benchmark(comp, bytes_per_point(2 * sizeof(float_type)));
+    }
+};
+
+TEST_F(layout_transformation_bandwidth, memcpy) {
+    auto comp = make_timed_function(
+        "memcpy", [&] { std::memcpy(m_dst.data(), m_src.data(), m_src.size() * sizeof(float_type)); });
+    benchmark(comp, bytes_per_point(2 * sizeof(float_type)));
+}
+
+// same layout as the source, line by line copy
+TEST_F(layout_transformation_bandwidth, fortran_to_fortran) { run_transform("fortran -> fortran", fortran_strides()); }
+
+// mc layout (layout_map<2, 0, 1>), the fastest dimension is the same as in the source
+TEST_F(layout_transformation_bandwidth, fortran_to_mc) { run_transform("fortran -> mc", {1, d1() * d3(), d1()}); }
+
+// x86 layout (layout_map<0, 1, 2>), the fastest dimension changes, tiled transpose
+TEST_F(layout_transformation_bandwidth, fortran_to_x86) {
+    run_transform("fortran -> x86", {d2() * d3(), d3(), 1});
+}
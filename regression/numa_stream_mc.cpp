@@ -0,0 +1,207 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * STREAM-like benchmark (copy, scale, add, triad) of the mc backend for the NUMA placement policies of mc_storage.
+ * As reference, the `serial` variant places all pages on the NUMA node of the master thread. If libnuma is available
+ * (GT_MC_USE_LIBNUMA), the fraction of pages that are local to the threads computing them is reported as well.
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+using namespace gridtools;
+
+namespace {
+    struct copy {
+        using a = inout_accessor<0>;
+        using b = in_accessor<1>;
+        using c = in_accessor<2>;
+        using param_list = make_param_list<a, b, c>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(a()) = eval(b());
+        }
+    };
+
+    struct scale {
+        using a = inout_accessor<0>;
+        using b = in_accessor<1>;
+        using c = in_accessor<2>;
+        using param_list = make_param_list<a, b, c>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(a()) = 3 * eval(b());
+        }
+    };
+
+    struct add {
+        using a = inout_accessor<0>;
+        using b = in_accessor<1>;
+        using c = in_accessor<2>;
+        using param_list = make_param_list<a, b, c>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(a()) = eval(b()) + eval(c());
+        }
+    };
+
+    struct triad {
+        using a = inout_accessor<0>;
+        using b = in_accessor<1>;
+        using c = in_accessor<2>;
+        using param_list = make_param_list<a, b, c>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(a()) = eval(b()) + 3 * eval(c());
+        }
+    };
+
+    // pages are touched by the master thread only
+    struct serial {};
+
+    template <class Placement>
+    struct placement_name;
+    template <>
+    struct placement_name<serial> {
+        static constexpr const char *value = "serial";
+    };
+    template <>
+    struct placement_name<numa_placement_mc::none> {
+        static constexpr const char *value = "none";
+    };
+    template <>
+    struct placement_name<numa_placement_mc::first_touch> {
+        static constexpr const char *value = "first_touch";
+    };
+    template <>
+    struct placement_name<numa_placement_mc::interleave> {
+        static constexpr const char *value = "interleave";
+    };
+    template <>
+    struct placement_name<numa_placement_mc::bind> {
+        static constexpr const char *value = "bind";
+    };
+
+#ifdef GT_MC_USE_LIBNUMA
+    /**
+     * Fraction of the pages of the inner domain that are located on the NUMA node of the thread computing them.
+     */
+    template <class StorageInfo, class T>
+    double local_fraction(StorageInfo const &info, T const *ptr) {
+        if (numa_available() < 0)
+            return 1;
+        const std::uintptr_t page_size = sysconf(_SC_PAGESIZE);
+        execinfo_mc exinfo(_impl_numa_placement_mc::inner_region<StorageInfo>{info});
+        std::size_t local = 0, total = 0;
+#pragma omp parallel for collapse(2) reduction(+ : local, total)
+        for (int_t bj = 0; bj < exinfo.j_blocks(); ++bj) {
+            for (int_t bi = 0; bi < exinfo.i_blocks(); ++bi) {
+                auto block = exinfo.block(bi, bj);
+                int node = numa_node_of_cpu(sched_getcpu());
+                std::vector<void *> pages;
+                for (int_t j = block.j_first; j < block.j_first + block.j_block_size; ++j)
+                    for (int_t k = 0; k < info.template total_length<2>(); ++k) {
+                        auto addr = reinterpret_cast<std::uintptr_t>(ptr + info.index(block.i_first, j, k));
+                        addr = addr / page_size * page_size;
+                        if (pages.empty() || pages.back() != reinterpret_cast<void *>(addr))
+                            pages.push_back(reinterpret_cast<void *>(addr));
+                    }
+                std::vector<int> status(pages.size());
+                if (numa_move_pages(0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0)
+                    continue;
+                for (int s : status)
+                    local += s == node;
+                total += pages.size();
+            }
+        }
+        return total ? double(local) / total : 1;
+    }
+#endif
+} // namespace
+
+struct numa_stream_mc : regression_fixture<> {
+    template <class Placement>
+    using data_store_t = data_store<mc_storage<float_type, Placement>, storage_info_t>;
+
+    template <class DataStore>
+    DataStore make(float_type value, std::false_type) {
+        return DataStore{make_storage_info(), value};
+    }
+
+    template <class DataStore>
+    DataStore make(float_type value, std::true_type) {
+        // external memory initialized by the master thread
+        auto info = make_storage_info();
+        m_serial_buffers.emplace_back(info.padded_total_length(), value);
+        return DataStore{info, m_serial_buffers.back().data()};
+    }
+
+    storage_info_t make_storage_info() const { return {d1(), d2(), d3()}; }
+
+    template <class Functor, class DataStore>
+    void run(char const *name, int_t fields, DataStore &a, DataStore &b, DataStore &c) {
+        arg<0, DataStore> p_a;
+        arg<1, DataStore> p_b;
+        arg<2, DataStore> p_c;
+        auto comp = make_computation(
+            p_a = a, p_b = b, p_c = c, make_multistage(execute::parallel(), make_stage<Functor>(p_a, p_b, p_c)));
+        comp.run();
+        std::cout << name << std::endl;
+        benchmark(comp, bytes_per_point(fields * sizeof(float_type)));
+    }
+
+    template <class Placement>
+    void stream() {
+        using is_serial_t = std::is_same<Placement, serial>;
+        using ds_t = data_store_t<conditional_t<is_serial_t::value, numa_placement_mc::none, Placement>>;
+        auto a = make<ds_t>(1, is_serial_t{});
+        auto b = make<ds_t>(2, is_serial_t{});
+        auto c = make<ds_t>(0, is_serial_t{});
+
+        std::cout << "placement: " << placement_name<Placement>::value << std::endl;
+        run<copy>("copy", 2, c, a, b);
+        run<scale>("scale", 2, b, c, a);
+        run<add>("add", 3, c, a, b);
+        run<triad>("triad", 3, a, b, c);
+#ifdef GT_MC_USE_LIBNUMA
+        std::cout << "local pages: " << local_fraction(a.info(), a.get_storage_ptr()->get_cpu_ptr()) * 100 << " %"
+                  << std::endl;
+#endif
+
+        // c = 1, b = 3, c = 4, a = 15
+        verify(make_storage<ds_t>(15.), a);
+        verify(make_storage<ds_t>(3.), b);
+        verify(make_storage<ds_t>(4.), c);
+    }
+
+    std::vector<std::vector<float_type>> m_serial_buffers;
+};
+
+TEST_F(numa_stream_mc, serial) { stream<serial>(); }
+
+TEST_F(numa_stream_mc, none) { stream<numa_placement_mc::none>(); }
+
+TEST_F(numa_stream_mc, first_touch) { stream<numa_placement_mc::first_touch>(); }
+
+#ifdef GT_MC_USE_LIBNUMA
+TEST_F(numa_stream_mc, interleave) { stream<numa_placement_mc::interleave>(); }
+
+TEST_F(numa_stream_mc, bind) { stream<numa_placement_mc::bind>(); }
+#endif
@@ -0,0 +1,113 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Floating point performance of simple stencils, executed with and without explicit vector-lane execution on the mc
+ * backend (see backend_mc/simd_mc.hpp). All other backends ignore the `simd` marker and run both variants the same way.
+ */
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+using namespace gridtools;
+
+template <bool Simd>
+struct axpy {
+    using out = inout_accessor<0>;
+    using x = in_accessor<1>;
+    using y = in_accessor<2>;
+    using param_list = make_param_list<out, x, y>;
+    using simd = bool_constant<Simd>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = 3 * eval(x()) + eval(y());
+    }
+};
+
+template <bool Simd>
+struct lap {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+    using param_list = make_param_list<out, in>;
+    using simd = bool_constant<Simd>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+    }
+};
+
+template <bool Simd>
+struct smooth {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+    using param_list = make_param_list<out, in>;
+    using simd = bool_constant<Simd>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = .5 * eval(in()) + .075 * (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1))) +
+                      .05 * (eval(in(1, 1)) + eval(in(-1, 1)) + eval(in(-1, -1)) + eval(in(1, -1)));
+    }
+};
+
+struct simd_stencils : regression_fixture<1> {
+    storage_type in = make_storage([](int_t i, int_t j, int_t k) { return i * i + 2 * j - .5 * k; });
+    storage_type y = make_storage([](int_t i, int_t j, int_t k) { return i - j * k; });
+    storage_type out = make_storage(-1.);
+
+    storage_type const &field(decltype(p_1)) const { return in; }
+    storage_type const &field(decltype(p_2)) const { return y; }
+
+    template <class Functor, class Expected, class... Args>
+    void run_variant(Expected const &expected, double flops, Args const &... args) {
+        auto comp = make_computation(
+            p_0 = out, (args = field(args))..., make_multistage(execute::parallel(), make_stage<Functor>(p_0, args...)));
+        comp.run();
+        verify(make_storage(expected), out);
+        benchmark(comp, flops_per_point(flops));
+    }
+
+    template <template <bool> class Functor, class Expected, class... Args>
+    void run(Expected const &expected, double flops, Args const &... args) {
+        std::cout << "scalar:" << std::endl;
+        run_variant<Functor<false>>(expected, flops, args...);
+        std::cout << "simd:" << std::endl;
+        run_variant<Functor<true>>(expected, flops, args...);
+    }
+};
+
+TEST_F(simd_stencils, axpy) {
+    run<axpy>([](int_t i, int_t j, int_t k) { return 3 * (i * i + 2 * j - .5 * k) + i - j * k; }, 2, p_1, p_2);
+}
+
+TEST_F(simd_stencils, laplacian) {
+    auto f = [](int_t i, int_t j, int_t k) { return i * i + 2 * j - .5 * k; };
+    run<lap>(
+        [f](int_t i, int_t j, int_t k) {
+            return 4 * f(i, j, k) - (f(i + 1, j, k) + f(i, j + 1, k) + f(i - 1, j, k) + f(i, j - 1, k));
+        },
+        5,
+        p_1);
+}
+
+TEST_F(simd_stencils, smooth) {
+    auto f = [](int_t i, int_t j, int_t k) { return i * i + 2 * j - .5 * k; };
+    run<smooth>(
+        [f](int_t i, int_t j, int_t k) {
+            return .5 * f(i, j, k) + .075 * (f(i + 1, j, k) + f(i, j + 1, k) + f(i - 1, j, k) + f(i, j - 1, k)) +
+                   .05 * (f(i + 1, j + 1, k) + f(i - 1, j + 1, k) + f(i - 1, j - 1, k) + f(i + 1, j - 1, k));
+        },
+        11,
+        p_1);
+}
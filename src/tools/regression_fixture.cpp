@@ -9,14 +9,31 @@
  */
 #include <gridtools/tools/regression_fixture_impl.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <gtest/gtest.h>
 
 #include <gridtools/common/defs.hpp>
+#include <gridtools/tools/run_statistics.hpp>
 
 namespace gridtools {
     namespace _impl {
@@ -25,6 +42,72 @@ namespace gridtools {
         uint_t regression_fixture_base::s_d3 = 0;
         uint_t regression_fixture_base::s_steps = 0;
         bool regression_fixture_base::s_needs_verification = true;
+        bool regression_fixture_base::s_warm_cache = false;
+        bool regression_fixture_base::s_pin_threads = false;
+        std::string regression_fixture_base::s_json_file;
+
+        namespace {
+            struct benchmark_record {
+                std::string name;
+                std::vector<double> times;
+                run_statistics statistics;
+            };
+
+            struct benchmark_records {
+                std::string backend;
+                std::string precision;
+                uint_t halo = 0;
+                std::vector<benchmark_record> records;
+            };
+
+            benchmark_records &records() {
+                static benchmark_records res;
+                return res;
+            }
+
+            std::string json_string(std::string const &str) {
+                std::string res = "\"";
+                for (char c : str) {
+                    if (c == '"' || c == '\\')
+                        res += '\\';
+                    res += c;
+                }
+                return res + "\"";
+            }
+
+            // the time format of pyutils/perftest/time.py
+            std::string timestr() {
+                auto now = std::chrono::system_clock::now();
+                std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+                unsigned microseconds = static_cast<unsigned>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count() % 1000000);
+                char date[32], zone[8], fraction[16];
+                std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&seconds));
+                std::strftime(zone, sizeof(zone), "%z", std::localtime(&seconds));
+                std::snprintf(fraction, sizeof(fraction), ".%06u", microseconds);
+                return std::string(date) + fraction + zone;
+            }
+
+            std::string hostname() {
+#ifdef __linux__
+                char res[256] = {};
+                if (gethostname(res, sizeof(res) - 1) == 0)
+                    return res;
+#endif
+                return "";
+            }
+
+            std::string current_test_name() {
+                auto const *info = ::testing::UnitTest::GetInstance()->current_test_info();
+                std::string res = info ? std::string(info->test_case_name()) + "." + info->name() : "benchmark";
+                // several benchmarks in the same test are numbered
+                std::size_t count = 0;
+                for (auto const &record : records().records)
+                    if (record.name == res || record.name.compare(0, res.size() + 1, res + "#") == 0)
+                        ++count;
+                return count == 0 ? res : res + "#" + std::to_string(count);
+            }
+        } // namespace
 
         void regression_fixture_base::flush_cache() {
             static std::size_t n = 1024 * 1024 * 21 / 2;
@@ -37,11 +120,119 @@ namespace gridtools {
                 a[i] = b[i] * c[i];
         }
 
+        double regression_fixture_base::stream_bandwidth(bool measure) {
+            if (char const *env = std::getenv("GT_STREAM_BANDWIDTH"))
+                return std::atof(env);
+            if (!measure)
+                return 0;
+            static double res = [] {
+                std::size_t n = 1024 * 1024 * 21 / 2;
+                std::vector<double> a_(n), b_(n, 1.), c_(n, 2.);
+                double *a = a_.data();
+                double *b = b_.data();
+                double *c = c_.data();
+                double best = 0;
+                for (int run = 0; run != 5; ++run) {
+                    auto start = std::chrono::high_resolution_clock::now();
+#pragma omp parallel for
+                    for (std::size_t i = 0; i < n; i++)
+                        a[i] = b[i] + 3. * c[i];
+                    double seconds =
+                        std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+                    best = std::max(best, 3 * sizeof(double) * n / seconds * 1e-9);
+                }
+                return best;
+            }();
+            return res;
+        }
+
+        void regression_fixture_base::report_times(
+            std::vector<double> const &times, uint_t halo, char const *backend, char const *precision) {
+            if (times.empty())
+                return;
+            run_statistics stats = compute_run_statistics(times);
+            std::cout << "median [s]: " << stats.median << " (95% CI " << stats.median_ci_low << " - "
+                      << stats.median_ci_high << "), p5: " << stats.p05 << ", p95: " << stats.p95
+                      << ", mean: " << stats.mean << " +- " << stats.mean_ci_high - stats.mean << " ("
+                      << (s_warm_cache ? "warm" : "cold") << " cache, " << stats.count << " runs)" << std::endl;
+            auto &all = records();
+            all.backend = backend;
+            all.precision = precision;
+            all.halo = halo;
+            all.records.push_back({current_test_name(), times, stats});
+        }
+
+        void regression_fixture_base::pin_threads() {
+#if defined(__linux__) && defined(_OPENMP)
+            cpu_set_t allowed;
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+                return;
+            std::vector<int> cpus;
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &allowed))
+                    cpus.push_back(cpu);
+            // the threads of the OpenMP runtime are reused by the following parallel regions of the same size
+#pragma omp parallel
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpus[omp_get_thread_num() % cpus.size()], &set);
+                sched_setaffinity(0, sizeof(set), &set);
+            }
+#else
+            std::cerr << "Thread pinning is not supported on this platform" << std::endl;
+#endif
+        }
+
+        void regression_fixture_base::write_json() {
+            if (s_json_file.empty())
+                return;
+            auto const &all = records();
+            std::ostringstream out;
+            out.precision(9);
+            std::string now = timestr();
+            out << "{\n    \"datetime\": " << json_string(now) << ",\n    \"domain\": [" << s_d1 - 2 * all.halo
+                << ", " << s_d2 - 2 * all.halo << ", " << s_d3
+                << "],\n    \"runinfo\": {\"backend\": " << json_string(all.backend)
+                << ", \"clustername\": \"\", \"compiler\": " << json_string(__VERSION__)
+                << ", \"datetime\": " << json_string(now) << ", \"grid\": "
+#ifdef GT_ICOSAHEDRAL_GRIDS
+                << "\"icosahedral\""
+#else
+                << "\"structured\""
+#endif
+                << ", \"hostname\": " << json_string(hostname()) << ", \"name\": \"gridtools\", \"precision\": "
+                << json_string(all.precision) << ", \"version\": \"\"},\n    \"times\": [";
+            for (std::size_t i = 0; i != all.records.size(); ++i) {
+                auto const &record = all.records[i];
+                auto const &stats = record.statistics;
+                out << (i ? "," : "") << "\n        {\"stencil\": " << json_string(record.name)
+                    << ", \"cache\": " << (s_warm_cache ? "\"warm\"" : "\"cold\"") << ", \"measurements\": [";
+                for (std::size_t j = 0; j != record.times.size(); ++j)
+                    out << (j ? ", " : "") << record.times[j];
+                out << "], \"statistics\": {\"count\": " << stats.count << ", \"min\": " << stats.min
+                    << ", \"max\": " << stats.max << ", \"mean\": " << stats.mean << ", \"stddev\": " << stats.stddev
+                    << ", \"mean_ci\": [" << stats.mean_ci_low << ", " << stats.mean_ci_high
+                    << "], \"median\": " << stats.median << ", \"median_ci\": [" << stats.median_ci_low << ", "
+                    << stats.median_ci_high << "], \"percentiles\": {\"5\": " << stats.p05 << ", \"25\": " << stats.p25
+                    << ", \"50\": " << stats.median << ", \"75\": " << stats.p75 << ", \"95\": " << stats.p95
+                    << "}}}";
+            }
+            out << "\n    ],\n    \"version\": 0.5\n}\n";
+            std::ofstream file(s_json_file);
+            file << out.str();
+            if (!file)
+                std::cerr << "Could not write " << s_json_file << std::endl;
+        }
+
         void regression_fixture_base::init(int argc, char **argv) {
             if (argc < 4) {
                 std::cerr << "Usage: " << argv[0] << " "
-                          << "dimx dimy dimz tsteps\n\twhere args are integer sizes of the data fields and tsteps "
-                             "is the number of time steps to run in a benchmark run"
+                          << "dimx dimy dimz [tsteps [-d] [--warm-cache] [--pin-threads] [--json=file]]\n\twhere args "
+                             "are integer sizes of the data fields and tsteps is the number of time steps to run in a "
+                             "benchmark run\n\t-d: no verification\n\t--warm-cache: do not flush the caches "
+                             "between the benchmark runs\n\t--pin-threads: pin the OpenMP threads to the CPUs\n\t"
+                             "--json=file: write the times of the benchmark runs to file"
                           << std::endl;
                 exit(1);
             }
@@ -49,7 +240,22 @@ namespace gridtools {
             s_d2 = std::atoi(argv[2]);
             s_d3 = std::atoi(argv[3]);
             s_steps = argc > 4 ? std::atoi(argv[4]) : 0;
-            s_needs_verification = argc < 6 || std::strcmp(argv[5], "-d") != 0;
+            for (int i = 5; i < argc; ++i) {
+                if (std::strcmp(argv[i], "-d") == 0)
+                    s_needs_verification = false;
+                else if (std::strcmp(argv[i], "--warm-cache") == 0)
+                    s_warm_cache = true;
+                else if (std::strcmp(argv[i], "--pin-threads") == 0)
+                    s_pin_threads = true;
+                else if (std::strncmp(argv[i], "--json=", 7) == 0)
+                    s_json_file = argv[i] + 7;
+                else {
+                    std::cerr << "Unknown option " << argv[i] << std::endl;
+                    exit(1);
+                }
+            }
+            if (s_pin_threads)
+                pin_threads();
         }
     } // namespace _impl
 } // namespace gridtools
@@ -58,5 +264,7 @@ int main(int argc, char **argv) {
     // Pass command line arguments to googltest
     ::testing::InitGoogleTest(&argc, argv);
     gridtools::_impl::regression_fixture_base::init(argc, argv);
-    return RUN_ALL_TESTS();
+    int res = RUN_ALL_TESTS();
+    gridtools::_impl::regression_fixture_base::write_json();
+    return res;
 }
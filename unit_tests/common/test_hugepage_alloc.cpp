@@ -43,5 +43,50 @@ namespace gridtools {
             EXPECT_EQ(offsets.size(), checks);
         }
 
+        TEST(hugepage_alloc, configured_offsets) {
+            auto &config = hugepage_configuration();
+            auto old_config = config;
+            config.min_offset = 128;
+            config.max_offset = 512;
+            std::set<std::uintptr_t> offsets;
+            for (std::size_t i = 0; i < 6; ++i) {
+                double *ptr = static_cast<double *>(hugepage_alloc(sizeof(double)));
+                offsets.insert(reinterpret_cast<std::uintptr_t>(ptr) & 0xfff);
+                hugepage_free(ptr);
+            }
+            config = old_config;
+            EXPECT_EQ(offsets, (std::set<std::uintptr_t>{128, 256, 512}));
+        }
+
+        TEST(hugepage_alloc, statistics) {
+            auto &config = hugepage_configuration();
+            auto old_config = config;
+            for (auto mode : {hugepage_mode::none, hugepage_mode::transparent, hugepage_mode::hugetlbfs}) {
+                config.mode = mode;
+                auto before = hugepage_statistics();
+                std::size_t size = 5 * 1024 * 1024;
+                char *ptr = static_cast<char *>(hugepage_alloc(size));
+                for (std::size_t i = 0; i < size; i += 4096)
+                    ptr[i] = 1;
+                auto during = hugepage_statistics();
+                EXPECT_EQ(during.total_bytes - before.total_bytes, size);
+                std::size_t huge = during.hugetlb_bytes - before.hugetlb_bytes;
+                std::size_t transparent = during.transparent_bytes - before.transparent_bytes;
+                if (mode == hugepage_mode::none) {
+                    EXPECT_EQ(huge + transparent, 0);
+                } else {
+                    // whether the pages are available depends on the system, but they are never counted twice
+                    EXPECT_TRUE(huge == 0 || transparent == 0);
+                    EXPECT_LE(huge + transparent, size);
+                }
+                hugepage_free(ptr);
+                auto after = hugepage_statistics();
+                EXPECT_EQ(after.total_bytes, before.total_bytes);
+                EXPECT_EQ(after.hugetlb_bytes, before.hugetlb_bytes);
+                EXPECT_EQ(after.transparent_bytes, before.transparent_bytes);
+            }
+            config = old_config;
+        }
+
     } // namespace
 } // namespace gridtools
@@ -0,0 +1,97 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <gridtools/common/boollist.hpp>
+#include <gridtools/communication/low_level/Halo_Exchange_3D.hpp>
+#include <gridtools/communication/low_level/proc_grids_3D.hpp>
+
+using namespace gridtools;
+
+namespace {
+    typedef MPI_3D_process_grid_t<3> grid_type;
+
+    int index(int i, int j, int k) { return (i + 1) * 9 + (j + 1) * 3 + k + 1; }
+
+    /**
+       Every process sends to each neighbor its rank plus an offset that changes at every exchange and checks that
+       the ranks of the neighbors arrive, with the same buffers or after registering new ones.
+    */
+    class persistent_exchange {
+        Halo_Exchange_3D<grid_type> m_he;
+        int m_send[2][27];
+        int m_recv[2][27];
+        int m_pid;
+
+      public:
+        persistent_exchange(grid_type const &grid) : m_he(grid) {
+            MPI_Comm_rank(GCL_WORLD, &m_pid);
+            m_he.set_persistent_requests(true);
+        }
+
+        void register_buffers(int set) {
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (i != 0 || j != 0 || k != 0) {
+                            m_he.register_send_to_buffer(&m_send[set][index(i, j, k)], sizeof(int), i, j, k);
+                            m_he.register_receive_from_buffer(&m_recv[set][index(i, j, k)], sizeof(int), i, j, k);
+                        }
+        }
+
+        int exchange(int set, int offset) {
+            for (int n = 0; n < 27; ++n) {
+                m_send[set][n] = m_pid + offset;
+                m_recv[set][n] = -1;
+            }
+            int arrived[27] = {};
+            m_he.post_receives();
+            m_he.do_sends();
+            m_he.wait_each([&](int i, int j, int k) { ++arrived[index(i, j, k)]; });
+
+            int errors = 0;
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (i != 0 || j != 0 || k != 0) {
+                            errors += arrived[index(i, j, k)] != 1;
+                            errors += m_recv[set][index(i, j, k)] != m_he.proc_grid().proc(i, j, k) + offset;
+                        }
+            return errors;
+        }
+    };
+
+    grid_type make_grid() {
+        int nprocs;
+        MPI_Comm_size(GCL_WORLD, &nprocs);
+        int dims[3] = {0, 0, 0};
+        MPI_Dims_create(nprocs, 3, dims);
+        int period[3] = {1, 1, 1};
+        MPI_Comm comm;
+        MPI_Cart_create(GCL_WORLD, 3, dims, period, false, &comm);
+        grid_type grid(boollist<3>(true, true, true), comm);
+        MPI_Comm_free(&comm);
+        return grid;
+    }
+} // namespace
+
+TEST(Communication, Halo_Exchange_3D_persistent) {
+    persistent_exchange exchange(make_grid());
+
+    exchange.register_buffers(0);
+    for (int step = 0; step < 3; ++step)
+        EXPECT_EQ(0, exchange.exchange(0, 100 * step));
+
+    // the requests are initialized again for the new buffers
+    exchange.register_buffers(1);
+    for (int step = 3; step < 5; ++step)
+        EXPECT_EQ(0, exchange.exchange(1, 100 * step));
+}
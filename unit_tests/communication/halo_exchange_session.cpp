@@ -0,0 +1,139 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <gridtools/common/boollist.hpp>
+#include <gridtools/communication/halo_exchange.hpp>
+
+using namespace gridtools;
+
+namespace {
+    /**
+       A field of the local domain of size `sizes` with the halo widths `minus` and `plus` in each dimension. The
+       value of a point is given by the field id and by the global coordinates of the point, periodic in each
+       dimension.
+    */
+    template <class Layout>
+    struct test_field {
+        int m_id;
+        array<halo_descriptor, 3> m_halos;
+        array<int, 3> m_strides;
+        std::vector<double> m_data;
+
+        test_field(int id, array<int, 3> const &sizes, array<int, 3> const &minus, array<int, 3> const &plus)
+            : m_id(id) {
+            int total = 1;
+            for (int d = 0; d < 3; ++d) {
+                m_halos[d] = halo_descriptor(
+                    minus[d], plus[d], minus[d], minus[d] + sizes[d] - 1, minus[d] + sizes[d] + plus[d]);
+                total *= m_halos[d].total_length();
+            }
+            for (int d = 0; d < 3; ++d) {
+                m_strides[d] = 1;
+                for (int e = 0; e < 3; ++e)
+                    if (Layout::at(e) > Layout::at(d))
+                        m_strides[d] *= m_halos[e].total_length();
+            }
+            m_data.resize(total, -1);
+        }
+
+        double &operator()(int i, int j, int k) {
+            return m_data[i * m_strides[0] + j * m_strides[1] + k * m_strides[2]];
+        }
+
+        double expected(array<int, 3> const &coords, array<int, 3> const &dims, int i, int j, int k) const {
+            array<int, 3> p = {i, j, k};
+            double res = m_id;
+            for (int d = 0; d < 3; ++d) {
+                int size = m_halos[d].end() - m_halos[d].begin() + 1;
+                int global = p[d] - (int)m_halos[d].begin() + coords[d] * size;
+                global = (global + size * dims[d]) % (size * dims[d]);
+                res = 100 * res + global;
+            }
+            return res;
+        }
+
+        bool is_inner(int i, int j, int k) const {
+            array<int, 3> p = {i, j, k};
+            for (int d = 0; d < 3; ++d)
+                if (p[d] < (int)m_halos[d].begin() || p[d] > (int)m_halos[d].end())
+                    return false;
+            return true;
+        }
+
+        void init(array<int, 3> const &coords, array<int, 3> const &dims) {
+            for (int i = 0; i < (int)m_halos[0].total_length(); ++i)
+                for (int j = 0; j < (int)m_halos[1].total_length(); ++j)
+                    for (int k = 0; k < (int)m_halos[2].total_length(); ++k)
+                        (*this)(i, j, k) = is_inner(i, j, k) ? expected(coords, dims, i, j, k) : -1;
+        }
+
+        int errors(array<int, 3> const &coords, array<int, 3> const &dims) {
+            int res = 0;
+            for (int i = 0; i < (int)m_halos[0].total_length(); ++i)
+                for (int j = 0; j < (int)m_halos[1].total_length(); ++j)
+                    for (int k = 0; k < (int)m_halos[2].total_length(); ++k)
+                        if ((*this)(i, j, k) != expected(coords, dims, i, j, k))
+                            ++res;
+            return res;
+        }
+    };
+
+    template <class Layout>
+    void run_session_test() {
+        int dims_[3] = {0, 0, 0};
+        int nprocs;
+        MPI_Comm_size(GCL_WORLD, &nprocs);
+        MPI_Dims_create(nprocs, 3, dims_);
+        int period[3] = {1, 1, 1};
+        MPI_Comm comm;
+        MPI_Cart_create(GCL_WORLD, 3, dims_, period, false, &comm);
+        int coords_[3];
+        MPI_Cart_get(comm, 3, dims_, period, coords_);
+        array<int, 3> dims = {dims_[0], dims_[1], dims_[2]};
+        array<int, 3> coords = {coords_[0], coords_[1], coords_[2]};
+
+        using pattern_type = halo_exchange_dynamic_ut<Layout, layout_map<0, 1, 2>, double, gcl_cpu>;
+        pattern_type he(typename pattern_type::grid_type::period_type(true, true, true), comm);
+        typename pattern_type::session_type session(he.pattern().proc_grid());
+
+        // fields of different components, each with its own halo
+        test_field<Layout> u(1, {7, 6, 5}, {2, 1, 1}, {1, 2, 1});
+        test_field<Layout> v(2, {7, 6, 5}, {1, 1, 0}, {1, 1, 0});
+        test_field<Layout> tracer(3, {4, 5, 3}, {3, 2, 1}, {2, 3, 2});
+
+        for (int step = 0; step < 2; ++step) {
+            u.init(coords, dims);
+            v.init(coords, dims);
+            tracer.init(coords, dims);
+
+            session.add(u.m_data.data(), u.m_halos);
+            session.add(v.m_data.data(), v.m_halos);
+            session.add(tracer.m_data.data(), tracer.m_halos);
+            EXPECT_EQ(3, session.pending());
+
+            session.flush();
+            EXPECT_EQ(0, session.pending());
+
+            EXPECT_EQ(0, u.errors(coords, dims));
+            EXPECT_EQ(0, v.errors(coords, dims));
+            EXPECT_EQ(0, tracer.errors(coords, dims));
+        }
+
+        MPI_Comm_free(&comm);
+    }
+} // namespace
+
+TEST(halo_exchange_session, layout_012) { run_session_test<layout_map<0, 1, 2>>(); }
+
+TEST(halo_exchange_session, layout_210) { run_session_test<layout_map<2, 1, 0>>(); }
@@ -20,6 +20,7 @@
 #include <gridtools/boundary_conditions/value.hpp>
 #include <gridtools/distributed_boundaries/comm_traits.hpp>
 #include <gridtools/distributed_boundaries/distributed_boundaries.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
 #include <gridtools/storage/storage_facility.hpp>
 #include <gridtools/tools/backend_select.hpp>
 #include <gridtools/tools/mpi_unit_test_driver/device_binding.hpp>
@@ -520,3 +521,107 @@ TEST(DistributedBoundaries, Test) {
 
     EXPECT_THROW(cabc.exchange(a, b, c, d), std::runtime_error);
 }
+
+namespace {
+    struct lap_function {
+        using out = gridtools::inout_accessor<0>;
+        using in = gridtools::in_accessor<1, gridtools::extent<-1, 1, -1, 1>>;
+        using param_list = gridtools::make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+        }
+    };
+} // namespace
+
+TEST(DistributedBoundaries, SplitPhaseExchange) {
+
+#ifdef __CUDACC__
+    using comm_arch = gridtools::gcl_gpu;
+#else
+    using comm_arch = gridtools::gcl_cpu;
+#endif
+    using storage_tr = gridtools::storage_traits<backend_t>;
+
+    using namespace gridtools;
+
+    using storage_info_t = storage_tr::storage_info_t<1, 3, halo<1, 1, 0>>;
+    using storage_type = storage_tr::data_store_t<double, storage_info_t>;
+
+    const uint_t halo_size = 1;
+    uint_t d1 = 10;
+    uint_t d2 = 11;
+    uint_t d3 = 3;
+
+    storage_info_t storage_info(d1, d2, d3);
+
+    using cabc_t = distributed_boundaries<comm_traits<storage_type, comm_arch>>;
+
+    halo_descriptor di{halo_size, halo_size, halo_size, d1 - halo_size - 1, (unsigned)storage_info.padded_length<0>()};
+    halo_descriptor dj{halo_size, halo_size, halo_size, d2 - halo_size - 1, (unsigned)storage_info.padded_length<1>()};
+    halo_descriptor dk{0, 0, 0, d3 - 1, (unsigned)storage_info.total_length<2>()};
+    array<halo_descriptor, 3> halos{di, dj, dk};
+
+#ifdef GCL_MPI
+    int dims[3] = {0, 0, 0};
+    MPI_Dims_create(PROCS, 3, dims);
+    int period[3] = {1, 1, 1};
+    MPI_Comm CartComm;
+    MPI_Cart_create(GCL_WORLD, 3, dims, period, false, &CartComm);
+#else
+    MPI_Comm CartComm = GCL_WORLD;
+#endif
+
+    cabc_t cabc{halos, {false, false, false}, 1, CartComm};
+
+    int pi, pj, pk;
+    cabc.proc_grid().coords(pi, pj, pk);
+
+    auto init = [=](int i, int j, int k) {
+        bool inner = i >= (int)halo_size and j >= (int)halo_size and i < (int)d1 - (int)halo_size and
+                     j < (int)d2 - (int)halo_size;
+        return inner ? (i + pi * ((int)d1 - 2 * (int)halo_size)) * 1.5 + (j + pj * ((int)d2 - 2 * (int)halo_size)) +
+                           0.25 * k
+                     : -1.;
+    };
+
+    auto grid = make_grid(di, dj, d3);
+    auto make_lap = [](decltype(grid) const &grid, storage_type &out, storage_type &in) {
+        arg<0, storage_type> p_out;
+        arg<1, storage_type> p_in;
+        return make_computation<backend_t>(
+            grid, p_out = out, p_in = in, make_multistage(execute::parallel(), make_stage<lap_function>(p_out, p_in)));
+    };
+
+    // reference: exchange, then compute on the whole grid
+    storage_type in_ref(storage_info, init, "in_ref");
+    storage_type out_ref(storage_info, 0., "out_ref");
+    cabc.exchange(in_ref);
+    make_lap(grid, out_ref, in_ref).run();
+
+    // overlapped: compute the interior during the exchange, the rim afterwards
+    storage_type in(storage_info, init, "in");
+    storage_type out(storage_info, 0., "out");
+    auto split = cabc.split(grid);
+    ASSERT_EQ(split.interior.size(), 1);
+    ASSERT_EQ(split.rim.size(), 4);
+
+    cabc.start_exchange(in);
+    EXPECT_THROW(cabc.start_exchange(in), std::runtime_error);
+    for (auto &&g : split.interior)
+        make_lap(g, out, in).run();
+    cabc.finish_exchange();
+    EXPECT_THROW(cabc.finish_exchange(), std::runtime_error);
+    for (auto &&g : split.rim)
+        make_lap(g, out, in).run();
+
+    out.sync();
+    out_ref.sync();
+    auto out_v = make_host_view(out);
+    auto out_ref_v = make_host_view(out_ref);
+    for (int i = halo_size; i < (int)d1 - (int)halo_size; ++i)
+        for (int j = halo_size; j < (int)d2 - (int)halo_size; ++j)
+            for (int k = 0; k < (int)d3; ++k)
+                EXPECT_EQ(out_v(i, j, k), out_ref_v(i, j, k)) << i << ", " << j << ", " << k;
+}
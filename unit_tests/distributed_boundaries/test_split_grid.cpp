@@ -0,0 +1,83 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include <gridtools/distributed_boundaries/split_grid.hpp>
+
+using namespace gridtools;
+
+namespace {
+    // number of grids of the split covering each point of the original grid
+    template <typename Grid>
+    std::vector<int> coverage(Grid const &grid, split_grid_t<Grid> const &split) {
+        uint_t ni = grid.direction_i().total_length(), nj = grid.direction_j().total_length();
+        std::vector<int> result(ni * nj, 0);
+        auto add = [&](Grid const &g) {
+            EXPECT_EQ(g.k_min(), grid.k_min());
+            EXPECT_EQ(g.k_max(), grid.k_max());
+            for (uint_t i = g.i_low_bound(); i <= g.i_high_bound(); ++i)
+                for (uint_t j = g.j_low_bound(); j <= g.j_high_bound(); ++j)
+                    ++result[i + ni * j];
+        };
+        for (auto &&g : split.interior)
+            add(g);
+        for (auto &&g : split.rim)
+            add(g);
+        return result;
+    }
+
+    std::vector<int> expected_coverage(halo_descriptor const &di, halo_descriptor const &dj) {
+        std::vector<int> result(di.total_length() * dj.total_length(), 0);
+        for (uint_t i = di.begin(); i <= di.end(); ++i)
+            for (uint_t j = dj.begin(); j <= dj.end(); ++j)
+                result[i + di.total_length() * j] = 1;
+        return result;
+    }
+} // namespace
+
+TEST(split_grid, interior_and_rim) {
+    halo_descriptor di{2, 2, 2, 11, 14};
+    halo_descriptor dj{1, 3, 1, 8, 12};
+    auto grid = make_grid(di, dj, 5);
+    auto split = split_grid(grid, {di, dj, halo_descriptor(5)});
+
+    ASSERT_EQ(split.interior.size(), 1);
+    EXPECT_EQ(split.interior[0].i_low_bound(), 4);
+    EXPECT_EQ(split.interior[0].i_high_bound(), 9);
+    EXPECT_EQ(split.interior[0].j_low_bound(), 2);
+    EXPECT_EQ(split.interior[0].j_high_bound(), 5);
+    EXPECT_EQ(split.rim.size(), 4);
+    EXPECT_EQ(coverage(grid, split), expected_coverage(di, dj));
+}
+
+TEST(split_grid, one_sided_halo) {
+    halo_descriptor di{0, 1, 0, 9, 11};
+    halo_descriptor dj{0, 0, 0, 6, 7};
+    auto grid = make_grid(di, dj, 2);
+    auto split = split_grid(grid, {di, dj, halo_descriptor(2)});
+
+    ASSERT_EQ(split.interior.size(), 1);
+    EXPECT_EQ(split.rim.size(), 1);
+    EXPECT_EQ(coverage(grid, split), expected_coverage(di, dj));
+}
+
+TEST(split_grid, no_interior) {
+    halo_descriptor di{2, 2, 2, 5, 8};
+    halo_descriptor dj{2, 2, 2, 9, 12};
+    auto grid = make_grid(di, dj, 3);
+    auto split = split_grid(grid, {di, dj, halo_descriptor(3)});
+
+    EXPECT_TRUE(split.interior.empty());
+    EXPECT_EQ(split.rim.size(), 1);
+    EXPECT_EQ(coverage(grid, split), expected_coverage(di, dj));
+}
@@ -9,6 +9,7 @@
  */
 
 #include <gridtools/common/array.hpp>
+#include <gridtools/common/hypercube_iterator.hpp>
 #include <gridtools/interface/layout_transformation/layout_transformation.hpp>
 #include <gtest/gtest.h>
 
@@ -71,6 +72,38 @@ namespace {
             ptr[index(i)] = f(i);
         }
     }
+
+    // strides of a dense layout of `dims`, with the dimensions ordered from the fastest to the slowest in `order`
+    std::vector<uint_t> dense_strides(const std::vector<uint_t> &dims, const std::vector<uint_t> &order) {
+        std::vector<uint_t> strides(dims.size());
+        uint_t stride = 1;
+        for (uint_t d : order) {
+            strides[d] = stride;
+            stride *= dims[d];
+        }
+        return strides;
+    }
+
+    // transforms a field with a distinct value at every point and checks the result
+    template <uint_t dim, typename T>
+    void check_transform(
+        const std::vector<uint_t> &dims, const std::vector<uint_t> &dst_strides, const std::vector<uint_t> &src_strides) {
+        Index src_index(dims, src_strides);
+        std::vector<T> src(src_index.size());
+        init<dim>(src.data(), src_index, [&](const array<size_t, dim> &a) {
+            size_t res = 0;
+            for (uint_t d = 0; d < dim; ++d)
+                res = res * dims[d] + a[d];
+            return res;
+        });
+
+        Index dst_index(dims, dst_strides);
+        std::vector<T> dst(dst_index.size(), -1);
+
+        gridtools::interface::transform(dst.data(), src.data(), dims, dst_strides, src_strides);
+
+        verify<dim>(src.data(), src_index, dst.data(), dst_index);
+    }
 } // namespace
 
 TEST(layout_transformation, 3D_reverse_layout) {
@@ -197,3 +230,39 @@ TEST(layout_transformation, one_dimension_too_many) {
     delete src;
     delete dst;
 }
+
+// the sizes are not multiples of the tile size, so that the tiles at the end of each dimension are partial
+TEST(layout_transformation, 2D_tiled_with_remainder) {
+    std::vector<uint_t> dims{37, 41};
+    check_transform<2, double>(dims, dense_strides(dims, {1, 0}), dense_strides(dims, {0, 1}));
+    check_transform<2, float>(dims, dense_strides(dims, {1, 0}), dense_strides(dims, {0, 1}));
+}
+
+TEST(layout_transformation, 3D_tiled_with_remainder) {
+    std::vector<uint_t> dims{19, 3, 35};
+    // the fastest dimensions of source and destination are not next to each other
+    check_transform<3, double>(dims, dense_strides(dims, {2, 1, 0}), dense_strides(dims, {0, 1, 2}));
+    check_transform<3, double>(dims, dense_strides(dims, {0, 2, 1}), dense_strides(dims, {2, 1, 0}));
+}
+
+TEST(layout_transformation, 5D_tiled) {
+    std::vector<uint_t> dims{3, 18, 2, 5, 17};
+    check_transform<5, double>(dims, dense_strides(dims, {4, 2, 0, 3, 1}), dense_strides(dims, {1, 3, 4, 0, 2}));
+}
+
+TEST(layout_transformation, 5D_same_fastest_dimension) {
+    std::vector<uint_t> dims{3, 18, 2, 5, 17};
+    check_transform<5, double>(dims, dense_strides(dims, {1, 4, 2, 0, 3}), dense_strides(dims, {1, 0, 3, 2, 4}));
+}
+
+TEST(layout_transformation, 4D_with_unit_dimensions) {
+    std::vector<uint_t> dims{1, 23, 1, 20};
+    check_transform<4, double>(dims, dense_strides(dims, {3, 2, 1, 0}), dense_strides(dims, {0, 1, 2, 3}));
+}
+
+TEST(layout_transformation, 4D_padded) {
+    std::vector<uint_t> dims{21, 4, 3, 18};
+    std::vector<uint_t> src_strides{1, 24, 96, 288};
+    std::vector<uint_t> dst_strides{4 * 3 * 20, 3 * 20, 20, 1};
+    check_transform<4, double>(dims, dst_strides, src_strides);
+}
@@ -0,0 +1,107 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/boundary_stage.hpp>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/boundary_conditions/copy.hpp>
+#include <gridtools/boundary_conditions/zero.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+using namespace gridtools;
+
+struct copy_functor {
+    typedef accessor<0, intent::in> in;
+    typedef accessor<1, intent::inout> out;
+
+    typedef make_param_list<in, out> param_list;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation);
+};
+
+struct vertical_functor {
+    typedef accessor<0, intent::in, extent<0, 0, 0, 0, -1, 1>> in;
+    typedef accessor<1, intent::inout> out;
+
+    typedef make_param_list<in, out> param_list;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation);
+};
+
+struct horizontal_functor {
+    typedef accessor<0, intent::in, extent<-1, 1, 0, 0>> in;
+    typedef accessor<1, intent::inout> out;
+
+    typedef make_param_list<in, out> param_list;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation);
+};
+
+typedef gridtools::storage_traits<backend_t>::storage_info_t<0, 3> storage_info_t;
+typedef gridtools::storage_traits<backend_t>::data_store_t<float_type, storage_info_t> storage_t;
+
+typedef arg<0, storage_t> p_in;
+typedef arg<1, storage_t> p_mid;
+typedef arg<2, storage_t> p_out;
+
+template <class...>
+struct lst;
+
+template <class... Esfs>
+GT_META_DEFINE_ALIAS(map, get_extent_map, (lst<Esfs...>));
+
+typedef decltype(make_boundary_stage(zero_boundary(), p_mid())) mid_boundary_t;
+typedef decltype(make_boundary_stage(zero_boundary(), p_out())) out_boundary_t;
+typedef decltype(make_boundary_stage(copy_boundary(), p_out(), p_in())) copy_boundary_t;
+
+// the placeholders of the boundary stages are not read at all
+static_assert(boundary_stages_have_zero_extents<GT_META_CALL(map, decltype(make_stage<copy_functor>(p_in(), p_out()))),
+                  copy_boundary_t>::value,
+    "");
+
+// or only with a vertical extent
+static_assert(
+    boundary_stages_have_zero_extents<GT_META_CALL(map,
+                                          (decltype(make_stage<copy_functor>(p_in(), p_mid())),
+                                              decltype(make_stage<vertical_functor>(p_mid(), p_out())))),
+        mid_boundary_t,
+        out_boundary_t>::value,
+    "");
+
+// the halo of p_mid is read while the boundary stage writes it
+static_assert(
+    !boundary_stages_have_zero_extents<GT_META_CALL(map,
+                                           (decltype(make_stage<copy_functor>(p_in(), p_mid())),
+                                               decltype(make_stage<horizontal_functor>(p_mid(), p_out())))),
+        mid_boundary_t>::value,
+    "");
+
+// the extents of the other placeholders do not matter
+static_assert(
+    boundary_stages_have_zero_extents<GT_META_CALL(map,
+                                          (decltype(make_stage<horizontal_functor>(p_in(), p_mid())),
+                                              decltype(make_stage<copy_functor>(p_mid(), p_out())))),
+        mid_boundary_t,
+        out_boundary_t>::value,
+    "");
+
+// all the placeholders of a boundary stage are checked, also the ones it only reads
+static_assert(!boundary_stages_have_zero_extents<GT_META_CALL(map,
+                                                     (decltype(make_stage<horizontal_functor>(p_in(), p_mid())),
+                                                         decltype(make_stage<copy_functor>(p_mid(), p_out())))),
+                  copy_boundary_t>::value,
+    "");
+
+TEST(dummy, dummy) {}
@@ -0,0 +1,136 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/expandable_parameters/make_computation.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+using namespace gridtools;
+
+struct copy_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in());
+    }
+};
+
+// reads the neighbors, so that it depends on the results of the other threads in the previous computation
+struct smooth_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0));
+    }
+};
+
+struct computation_sequence_test : computation_fixture<1> {
+    computation_sequence_test() : computation_fixture<1>(37, 29, 11) {}
+
+    static double a(int i, int j, int k) { return i + 2 * j + 3 * k; }
+
+    // the halo of the intermediate field keeps the values of the input
+    static double b(int i, int j, int k) {
+        return i > 0 && i < 36 && j > 0 && j < 28
+                   ? a(i - 1, j, k) + a(i + 1, j, k) + a(i, j - 1, k) + a(i, j + 1, k)
+                   : a(i, j, k);
+    }
+
+    static double c(int i, int j, int k) { return b(i - 1, j, k) + b(i + 1, j, k) + b(i, j - 1, k) + b(i, j + 1, k); }
+
+    storage_type m_a = make_storage(a);
+    storage_type m_b = make_storage(a);
+    storage_type m_c = make_storage(-1.);
+
+    void expect_results() {
+        verify(make_storage(b), m_b);
+        verify(make_storage(c), m_c);
+    }
+};
+
+TEST_F(computation_sequence_test, run_all) {
+    auto first = make_computation(make_multistage(execute::parallel(), make_stage<smooth_functor>(p_0, p_1)));
+    auto second = make_computation(make_multistage(execute::forward(), make_stage<smooth_functor>(p_0, p_1)));
+    first.prepare(p_0 = m_b, p_1 = m_a);
+    second.prepare(p_0 = m_c, p_1 = m_b);
+
+    for (int i = 0; i != 3; ++i)
+        run_all(first, second);
+    expect_results();
+}
+
+// outside of a sequence, a computation forks its own threads even if called by a single thread of a parallel region
+TEST_F(computation_sequence_test, run_in_omp_single) {
+    auto first = make_computation(make_multistage(execute::parallel(), make_stage<smooth_functor>(p_0, p_1)));
+    auto second = make_computation(make_multistage(execute::forward(), make_stage<smooth_functor>(p_0, p_1)));
+#pragma omp parallel
+#pragma omp single
+    {
+        first.run(p_0 = m_b, p_1 = m_a);
+        second.run(p_0 = m_c, p_1 = m_b);
+    }
+    expect_results();
+}
+
+TEST_F(computation_sequence_test, temporaries) {
+    computation<> first = make_computation(p_0 = m_b,
+        p_1 = m_a,
+        make_multistage(execute::forward(),
+            make_stage<copy_functor>(p_tmp_0, p_1),
+            make_stage<smooth_functor>(p_0, p_tmp_0)));
+    computation<arg<0>, arg<1>> second = make_computation(make_multistage(execute::forward(),
+        make_stage<copy_functor>(p_tmp_0, p_1),
+        make_stage<smooth_functor>(p_tmp_1, p_tmp_0),
+        make_stage<copy_functor>(p_0, p_tmp_1)));
+    first.prepare();
+    second.prepare(p_1 = m_b, p_0 = m_c);
+
+    computation_sequence sequence;
+    sequence.add(first).add(second);
+    EXPECT_EQ(2, sequence.size());
+    sequence.run();
+    sequence.run();
+    expect_results();
+}
+
+TEST_F(computation_sequence_test, expandable) {
+    using storages_t = std::vector<storage_type>;
+    arg<0, storages_t> p_out;
+    arg<1, storages_t> p_in;
+
+    storages_t as = {m_a, make_storage(a), make_storage(a)};
+    storages_t bs = {m_b, make_storage(a), make_storage(a)};
+    storages_t cs = {m_c, make_storage(-1.), make_storage(-1.)};
+    auto first = make_expandable_computation<backend_t>(expand_factor<2>(),
+        make_grid(),
+        p_out = bs,
+        p_in = as,
+        make_multistage(execute::parallel(), make_stage<smooth_functor>(p_out, p_in)));
+    auto second = make_expandable_computation<backend_t>(
+        expand_factor<2>(), make_grid(), make_multistage(execute::parallel(), make_stage<smooth_functor>(p_out, p_in)));
+    first.prepare();
+    second.prepare(p_out = cs, p_in = bs);
+
+    run_all(first, second);
+    expect_results();
+    for (size_t i = 1; i != cs.size(); ++i)
+        verify(m_c, cs[i]);
+}
@@ -0,0 +1,14 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+// the temporaries of the nested setups of a sequence are borrowed from the pool at the same time
+#define GT_MC_TMP_POOL
+
+#include "test_computation_sequence.cpp"
@@ -100,4 +100,47 @@ namespace gridtools {
         for (bool res : verify(in, out))
             EXPECT_TRUE(res);
     }
+
+    TEST_F(fixture, run_prepared) {
+        auto in = make_in(3);
+        auto out = make_out();
+
+        m_computation.prepare(p_in{} = in, p_out{} = out);
+        m_computation.run_prepared();
+        for (bool res : verify(in, out))
+            EXPECT_TRUE(res);
+        m_computation.run(p_in{} = make_in(7), p_out{} = make_out());
+        // all the prepared outputs share the same memory
+        out[0].sync();
+        auto out_view = make_host_view(out[0]);
+        for (uint_t i = 0; i != m_d1; ++i)
+            for (uint_t j = 0; j != m_d2; ++j)
+                for (uint_t k = 0; k != m_d3; ++k)
+                    out_view(i, j, k) = -1;
+        out[0].sync();
+        m_computation.run_prepared();
+        for (bool res : verify(in, out))
+            EXPECT_TRUE(res);
+    }
+
+    TEST_F(fixture, reassign_single_storage) {
+        auto in = make_in(3);
+        // output storages should not share their memory
+        std::vector<storage_t> out;
+        for (size_t i = 0; i != in.size(); ++i)
+            out.push_back(make_out()[0]);
+
+        m_computation.run(p_in{} = in, p_out{} = out);
+        for (bool res : verify(in, out))
+            EXPECT_TRUE(res);
+        in[2] = make_in(7)[0];
+        m_computation.run(p_in{} = in, p_out{} = out);
+        for (bool res : verify(in, out))
+            EXPECT_TRUE(res);
+        in.push_back(make_in(9)[0]);
+        out.push_back(make_out()[0]);
+        m_computation.run(p_in{} = in, p_out{} = out);
+        for (bool res : verify(in, out))
+            EXPECT_TRUE(res);
+    }
 } // namespace gridtools
@@ -0,0 +1,125 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+using namespace gridtools;
+
+struct copy_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in());
+    }
+};
+
+struct smooth_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0));
+    }
+};
+
+struct scale_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = 2 * eval(in());
+    }
+};
+
+struct fuse_computations_test : computation_fixture<1> {
+    fuse_computations_test() : computation_fixture<1>(23, 19, 7) {}
+
+    static double a(int i, int j, int k) { return i + 2 * j + 3 * k; }
+    static double smooth(int i, int j, int k) {
+        return a(i - 1, j, k) + a(i + 1, j, k) + a(i, j - 1, k) + a(i, j + 1, k);
+    }
+    static double scale(int i, int j, int k) { return 2 * a(i, j, k); }
+
+    storage_type m_a = make_storage(a);
+    storage_type m_smooth = make_storage(-1.);
+    storage_type m_scale = make_storage(-1.);
+    storage_type m_copy = make_storage(-1.);
+
+    void expect_results() {
+        verify(make_storage(smooth), m_smooth);
+        verify(make_storage(scale), m_scale);
+        verify(m_a, m_copy);
+    }
+};
+
+TEST_F(fuse_computations_test, shared_input) {
+    auto first =
+        make_computation(p_1 = m_smooth, make_multistage(execute::parallel(), make_stage<smooth_functor>(p_1, p_0)));
+    auto second = make_computation(make_multistage(execute::parallel(), make_stage<scale_functor>(p_2, p_0)));
+    auto third =
+        make_computation(p_3 = m_copy, make_multistage(execute::parallel(), make_stage<copy_functor>(p_3, p_0)));
+
+    auto fused = fuse_computations(first, second, third);
+    static_assert(decltype(fused.get_arg_intent(p_0))::value == intent::in, "");
+    static_assert(decltype(fused.get_arg_intent(p_2))::value == intent::inout, "");
+    static_assert(std::is_same<decltype(fused.get_arg_extent(p_0)), extent<-1, 1, -1, 1>>::value, "");
+
+    fused.run(p_0 = m_a, p_2 = m_scale);
+    expect_results();
+}
+
+TEST_F(fuse_computations_test, temporaries) {
+    auto first = make_computation(make_multistage(execute::forward(),
+        make_stage<copy_functor>(p_tmp_0, p_0),
+        make_stage<smooth_functor>(p_1, p_tmp_0)));
+    auto second = make_computation(make_multistage(execute::forward(),
+        make_stage<scale_functor>(p_tmp_1, p_0),
+        make_stage<copy_functor>(p_2, p_tmp_1),
+        make_stage<copy_functor>(p_3, p_0)));
+
+    computation<arg<0>, arg<1>, arg<2>, arg<3>> fused = fuse_computations(first, second);
+    fused.run(p_0 = m_a, p_1 = m_smooth, p_2 = m_scale, p_3 = m_copy);
+    expect_results();
+}
+
+TEST_F(fuse_computations_test, multistages) {
+    storage_type tmp = make_storage(-1.);
+    auto first = make_computation(p_1 = m_smooth,
+        p_4 = tmp,
+        make_multistage(execute::parallel(), make_stage<copy_functor>(p_4, p_0)),
+        make_multistage(execute::backward(), make_stage<smooth_functor>(p_1, p_4)));
+    auto second = make_computation(make_multistage(execute::parallel(), make_stage<scale_functor>(p_2, p_0)),
+        make_multistage(execute::backward(), make_stage<copy_functor>(p_3, p_0)));
+
+    auto fused = fuse_computations(first, second);
+    fused.run(p_0 = m_a, p_2 = m_scale, p_3 = m_copy);
+    expect_results();
+}
+
+TEST_F(fuse_computations_test, different_grids) {
+    auto first = make_computation(make_multistage(execute::parallel(), make_stage<copy_functor>(p_1, p_0)));
+    auto second = gridtools::make_computation<backend_t>(
+        gridtools::make_grid(i_halo_descriptor(), j_halo_descriptor(), axis<1>{5u}),
+        make_multistage(execute::parallel(), make_stage<copy_functor>(p_2, p_0)));
+
+    EXPECT_THROW(fuse_computations(first, second), std::runtime_error);
+}
@@ -54,3 +54,34 @@ TEST(mss_metafunctions, extract_mss_caches_and_esfs) {
     static_assert(std::is_same<mss_t::cache_sequence_t>::value, "ERROR\nList not empty");
 #endif
 }
+
+TEST(mss_metafunctions, split_mss_k_caches) {
+    typedef arg<3, storage_t> p_out2;
+    typedef decltype(make_stage<functor1>(p_in(), p_buff())) esf1_t;
+    typedef decltype(make_stage<functor1>(p_buff(), p_out())) esf2_t;
+    typedef decltype(make_stage<functor1>(p_in(), p_out2())) esf3_t;
+
+    typedef decltype(make_multistage(execute::forward(),
+        define_caches(cache<cache_type::k, cache_io_policy::local>(p_buff()),
+            cache<cache_type::k, cache_io_policy::flush>(p_out2()),
+            cache<cache_type::ij, cache_io_policy::local>(p_out())),
+        esf1_t(),
+        esf2_t(),
+        esf3_t())) mss_t;
+
+    using split_t = mss_comonents_metafunctions_impl_::split_mss_into_independent_esfs<false, std::tuple<mss_t>>::type;
+    static_assert(meta::length<split_t>::value == 3, "");
+
+#ifndef GT_DISABLE_CACHING
+    // the k cache of p_buff is dropped as p_buff is passed between two ESFs, ij caches are kept
+    using ij_cache_t = detail::cache_impl<cache_type::ij, p_out, cache_io_policy::local>;
+    using k_cache_t = detail::cache_impl<cache_type::k, p_out2, cache_io_policy::flush>;
+    static_assert(std::is_same<GT_META_CALL(meta::at_c, (split_t, 0))::cache_sequence_t, std::tuple<ij_cache_t>>::value,
+        "");
+    static_assert(std::is_same<GT_META_CALL(meta::at_c, (split_t, 1))::cache_sequence_t, std::tuple<ij_cache_t>>::value,
+        "");
+    static_assert(std::is_same<GT_META_CALL(meta::at_c, (split_t, 2))::cache_sequence_t,
+                      std::tuple<k_cache_t, ij_cache_t>>::value,
+        "");
+#endif
+}
@@ -0,0 +1,81 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#define GT_ENABLE_STAGE_METERS
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stage_meters.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+using namespace gridtools;
+
+struct copy_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in());
+    }
+};
+
+struct smooth_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0));
+    }
+};
+
+struct stage_meters_test : computation_fixture<1> {
+    stage_meters_test() : computation_fixture<1>(37, 29, 11) { stage_meters::instance().reset(); }
+};
+
+TEST_F(stage_meters_test, names) {
+    using stage_t = regular_stage<copy_functor, extent<>, std::tuple<arg<0>, arg<1>>>;
+    using other_stage_t = regular_stage<smooth_functor, extent<>, std::tuple<arg<0>, arg<1>>>;
+    EXPECT_EQ("copy_functor", stage_meters_impl_::stage_name<stage_t>::get());
+    EXPECT_EQ(
+        "copy_functor+smooth_functor", (stage_meters_impl_::stage_name<compound_stage<stage_t, other_stage_t>>::get()));
+}
+
+TEST_F(stage_meters_test, run) {
+    auto comp = make_computation(p_0 = make_storage(-1.),
+        p_1 = make_storage(1.),
+        make_multistage(execute::forward(),
+            make_stage<copy_functor>(p_tmp_0, p_1),
+            make_stage<smooth_functor>(p_0, p_tmp_0)));
+    comp.run();
+    comp.run();
+
+    std::string json = stage_meters::instance().to_json();
+    EXPECT_EQ("{\"stages\": [", json.substr(0, 12));
+#if defined(GT_BACKEND_MC) || defined(GT_BACKEND_X86)
+    EXPECT_NE(std::string::npos, json.find("{\"stage\": \"copy_functor\""));
+    EXPECT_NE(std::string::npos, json.find("{\"stage\": \"smooth_functor\""));
+    EXPECT_NE(std::string::npos, json.find("\"threads\": [{\"thread\": "));
+    EXPECT_GT(stage_meters::instance().total_time("copy_functor"), 0);
+    EXPECT_GT(stage_meters::instance().total_time("smooth_functor"), 0);
+#else
+    EXPECT_EQ("{\"stages\": []}", json);
+#endif
+
+    stage_meters::instance().reset();
+    EXPECT_EQ("{\"stages\": []}", stage_meters::instance().to_json());
+}
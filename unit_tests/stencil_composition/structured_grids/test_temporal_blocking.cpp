@@ -0,0 +1,108 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/stencil_composition/temporal_blocking.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+using namespace gridtools;
+
+struct diffusion_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) =
+            eval(in()) + .1 * (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0)) -
+                                  4 * eval(in()));
+    }
+};
+
+struct lap_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) =
+            4 * eval(in()) - (eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0)));
+    }
+};
+
+// reads the input with an extent of 2 in i and 1 in j through a temporary, and a coefficient field
+struct update_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1>;
+    using lap = in_accessor<2, extent<-1, 1, 0, 0>>;
+    using coeff = in_accessor<3>;
+
+    using param_list = make_param_list<out, in, lap, coeff>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in()) - eval(coeff()) * (eval(lap(-1, 0, 0)) + eval(lap(1, 0, 0)));
+    }
+};
+
+struct temporal_blocking_test : computation_fixture<2> {
+    temporal_blocking_test() : computation_fixture<2>(29, 23, 5) {}
+
+    static double initial(int i, int j, int k) { return (i * 7 + j * 13 + k * 5) % 11 + 1. / (1 + i + j); }
+
+    template <class Comp, class... Args>
+    void expect_same_as_separate_runs(Comp &comp, uint_t steps, temporal_blocking blocking, Args const &... args) {
+        storage_type expected_in = make_storage(initial);
+        storage_type expected_out = make_storage(initial);
+        for (uint_t t = 0; t < steps; ++t) {
+            comp.run(p_1 = expected_in, p_0 = expected_out, args...);
+            std::swap(expected_in, expected_out);
+        }
+
+        storage_type in = make_storage(initial);
+        storage_type out = make_storage(initial);
+        run_temporally_blocked(comp, steps, blocking, p_1, in, p_0, out, args...);
+
+        auto expected_in_view = make_host_view(expected_in);
+        auto expected_out_view = make_host_view(expected_out);
+        auto in_view = make_host_view(in);
+        auto out_view = make_host_view(out);
+        for (int i = 0; i < (int)d1(); ++i)
+            for (int j = 0; j < (int)d2(); ++j)
+                for (int k = 0; k < (int)d3(); ++k) {
+                    ASSERT_EQ(expected_in_view(i, j, k), in_view(i, j, k)) << i << " " << j << " " << k;
+                    ASSERT_EQ(expected_out_view(i, j, k), out_view(i, j, k)) << i << " " << j << " " << k;
+                }
+    }
+};
+
+TEST_F(temporal_blocking_test, diffusion) {
+    auto comp = make_computation(make_multistage(execute::parallel(), make_stage<diffusion_functor>(p_0, p_1)));
+    expect_same_as_separate_runs(comp, 10, {4, 5, 7});
+    expect_same_as_separate_runs(comp, 7, {3, 1, 0});
+    expect_same_as_separate_runs(comp, 5, {5, 0, 0});
+    expect_same_as_separate_runs(comp, 6, {1, 8, 8});
+}
+
+TEST_F(temporal_blocking_test, temporaries) {
+    auto comp = make_computation(make_multistage(execute::forward(),
+        make_stage<lap_functor>(p_tmp_0, p_1),
+        make_stage<update_functor>(p_0, p_1, p_tmp_0, p_2)));
+    storage_type coeff = make_storage([](int i, int j, int k) { return .01 * (1 + (i + j + k) % 3); });
+    expect_same_as_separate_runs(comp, 9, {4, 6, 5}, p_2 = coeff);
+    expect_same_as_separate_runs(comp, 4, {2, 3, 0}, p_2 = coeff);
+}
@@ -0,0 +1,92 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+using namespace gridtools;
+using namespace expressions;
+
+struct copy_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1>;
+
+    using param_list = make_param_list<out, in>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in());
+    }
+};
+
+struct smooth_functor {
+    using out = inout_accessor<0>;
+    using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+    using param_list = make_param_list<out, in>;
+    using flops = expr_flops<decltype(in(-1, 0, 0) + in(1, 0, 0) + in(0, -1, 0) + in(0, 1, 0))>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(in(-1, 0, 0) + in(1, 0, 0) + in(0, -1, 0) + in(0, 1, 0));
+    }
+};
+
+struct axpy_functor {
+    using out = inout_accessor<0>;
+    using x = in_accessor<1>;
+    using y = in_accessor<2>;
+
+    using param_list = make_param_list<out, x, y>;
+    using flops = expr_flops<decltype(2 * x() + y())>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(out()) = eval(2 * x() + y());
+    }
+};
+
+static_assert(expr_flops<decltype(-in_accessor<0>())>::value == 1, "");
+static_assert(expr_flops<decltype(+in_accessor<0>())>::value == 0, "");
+static_assert(expr_flops<decltype(pow<3>(in_accessor<0>()))>::value == 2, "");
+static_assert(expr_flops<decltype(in_accessor<0>() / 2), decltype(in_accessor<0>() - 1)>::value == 2, "");
+
+struct traffic_model_test : computation_fixture<1> {
+    traffic_model_test() : computation_fixture<1>(23, 19, 7) {}
+
+    // the compute domain is 21 x 17 x 7 points
+    double const points = 21 * 17 * 7;
+    double const value_size = sizeof(float_type);
+};
+
+TEST_F(traffic_model_test, extents) {
+    auto comp = make_computation(make_multistage(execute::parallel(), make_stage<smooth_functor>(p_1, p_0)));
+
+    auto model = comp.get_traffic_model();
+    EXPECT_EQ(model.bytes_read, 23 * 19 * 7 * value_size);
+    EXPECT_EQ(model.bytes_written, points * value_size);
+    EXPECT_TRUE(model.has_flops);
+    EXPECT_EQ(model.flops, 3 * points);
+    EXPECT_EQ(model.arithmetic_intensity(), model.flops / model.bytes());
+}
+
+TEST_F(traffic_model_test, temporaries) {
+    computation<arg<0>, arg<1>, arg<2>> comp = make_computation(make_multistage(execute::parallel(),
+        make_stage<copy_functor>(p_tmp_0, p_0),
+        make_stage<axpy_functor>(p_2, p_tmp_0, p_1)));
+
+    auto model = comp.get_traffic_model();
+    EXPECT_EQ(model.bytes_read, 2 * points * value_size);
+    EXPECT_EQ(model.bytes_written, points * value_size);
+    // copy_functor does not declare its operations
+    EXPECT_FALSE(model.has_flops);
+    EXPECT_EQ(model.flops, 2 * points);
+}
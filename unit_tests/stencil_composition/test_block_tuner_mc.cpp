@@ -0,0 +1,94 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include <gridtools/stencil_composition/grid.hpp>
+#include <gridtools/stencil_composition/structured_grids/backend_mc/block_tuner_mc.hpp>
+
+using namespace gridtools;
+
+namespace {
+    struct stencil_a {};
+    struct stencil_b {};
+} // namespace
+
+TEST(block_tuner_mc, default_shape_first) {
+    auto grid = make_grid(64, 48, 10);
+    execinfo_mc default_exinfo(grid);
+
+    block_tuner_mc &tuner = get_block_tuner_mc<stencil_a>(grid);
+    ASSERT_FALSE(tuner.tuned());
+    auto exinfo = tuner.execinfo(grid);
+    EXPECT_EQ(exinfo.i_block_size(), default_exinfo.i_block_size());
+    EXPECT_EQ(exinfo.j_block_size(), default_exinfo.j_block_size());
+    EXPECT_EQ(exinfo.i_blocks(), default_exinfo.i_blocks());
+    EXPECT_EQ(exinfo.j_blocks(), default_exinfo.j_blocks());
+}
+
+TEST(block_tuner_mc, selects_fastest) {
+    auto grid = make_grid(64, 48, 10);
+    execinfo_mc default_exinfo(grid);
+
+    block_tuner_mc &tuner = get_block_tuner_mc<stencil_b>(grid);
+
+    // the warm-up run uses the default shape and its time is ignored, even if it is the smallest one
+    auto warm_up = tuner.execinfo(grid);
+    EXPECT_EQ(warm_up.i_block_size(), default_exinfo.i_block_size());
+    EXPECT_EQ(warm_up.j_block_size(), default_exinfo.j_block_size());
+    tuner.report(0);
+    ASSERT_FALSE(tuner.tuned());
+
+    int_t fastest_i = 0, fastest_j = 0;
+    for (int run = 0; !tuner.tuned(); ++run) {
+        auto exinfo = tuner.execinfo(grid);
+        EXPECT_LE(exinfo.i_block_size(), default_exinfo.i_block_size());
+        EXPECT_LE(exinfo.j_block_size(), default_exinfo.j_block_size());
+        // the third candidate is reported to be the fastest
+        if (run == 2) {
+            fastest_i = exinfo.i_block_size();
+            fastest_j = exinfo.j_block_size();
+        }
+        tuner.report(run == 2 ? 1 : 2);
+    }
+    ASSERT_GT(fastest_i, 0);
+    auto exinfo = tuner.execinfo(grid);
+    EXPECT_EQ(exinfo.i_block_size(), fastest_i);
+    EXPECT_EQ(exinfo.j_block_size(), fastest_j);
+
+    // the same tuner is returned for the same stencil and grid
+    EXPECT_EQ(&tuner, &get_block_tuner_mc<stencil_b>(grid));
+}
+
+TEST(block_tuner_mc, tuning_cache) {
+    const char *path = "test_block_tuner_mc.cache";
+    std::remove(path);
+    {
+        _impl_block_tuner_mc::tuning_cache cache(path);
+        cache.store("key_a", {4, 2});
+        cache.store("key_b", {16, 1});
+        cache.store("key_a", {8, 3});
+    }
+
+    // a new cache, as created after a restart, reads the stored shapes back
+    _impl_block_tuner_mc::tuning_cache cache(path);
+    _impl_block_tuner_mc::block_shape shape;
+    ASSERT_TRUE(cache.lookup("key_a", shape));
+    EXPECT_EQ(shape.i_block_size, 8);
+    EXPECT_EQ(shape.j_block_size, 3);
+    ASSERT_TRUE(cache.lookup("key_b", shape));
+    EXPECT_EQ(shape.i_block_size, 16);
+    EXPECT_EQ(shape.j_block_size, 1);
+    EXPECT_FALSE(cache.lookup("key_c", shape));
+
+    std::remove(path);
+}
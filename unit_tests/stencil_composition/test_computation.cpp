@@ -40,6 +40,16 @@ namespace gridtools {
                 ++m_count;
             }
 
+            template <class... Args, class... DataStores>
+            void prepare(arg_storage_pair<Args, DataStores> const &...) {}
+
+            void run_prepared() { ++m_count; }
+
+            template <class Fun>
+            void setup_prepared_run(Fun const &fun) {
+                fun([this] { ++m_count; });
+            }
+
             void reset_meter() { m_count = 0; }
             std::string print_meter() const {
                 std::ostringstream strm;
@@ -48,6 +58,11 @@ namespace gridtools {
             }
             size_t get_count() const { return m_count; }
             double get_time() const { return 0.; /* unused */ }
+            traffic_model get_traffic_model() const {
+                traffic_model res;
+                res.bytes_read = m_count;
+                return res;
+            }
 
             template <typename Arg>
             static rt_extent get_arg_extent(Arg) {
@@ -81,6 +96,12 @@ namespace gridtools {
             // testee.run(a{} = data());
         }
 
+        TEST(computation, traffic_model) {
+            computation<> testee = my_computation{};
+            testee.run();
+            EXPECT_EQ(testee.get_traffic_model().bytes_read, 1);
+        }
+
         TEST(computation, move) {
             auto make = []() { return computation<>(my_computation{}); };
             auto testee = make();
@@ -113,6 +134,27 @@ namespace gridtools {
             testee.run(b{} = data("bar"), a{} = data("foo"));
         }
 
+        TEST(computation, prepared_run) {
+            computation<a, b> testee = my_computation{};
+            testee.prepare(b{} = data("bar"), a{} = data("foo"));
+            testee.run_prepared();
+            testee.run_prepared();
+            EXPECT_EQ(testee.get_count(), 2);
+        }
+
+        TEST(computation, setup_prepared_run) {
+            computation<a> testee = my_computation{};
+            testee.prepare(a{} = data("foo"));
+            bool called = false;
+            testee.setup_prepared_run([&](std::function<void()> const &loop) {
+                EXPECT_EQ(testee.get_count(), 0);
+                loop();
+                called = true;
+            });
+            EXPECT_TRUE(called);
+            EXPECT_EQ(testee.get_count(), 1);
+        }
+
         TEST(computation, convertible_args) {
             computation<a, b> tmp = my_computation{};
             tmp.run(a{} = data(), b{} = data());
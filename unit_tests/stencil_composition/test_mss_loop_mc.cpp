@@ -0,0 +1,93 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <gridtools/stencil_composition/execution_types.hpp>
+#include <gridtools/stencil_composition/grid.hpp>
+#include <gridtools/stencil_composition/structured_grids/backend_mc/mss_loop_mc.hpp>
+
+/**
+  @file
+  The mc backend ignores k caches: each stage loops over j, k and i of a block, in this order, so the k-neighbours of
+  a point have been accessed one i-row of the block before and are still in the L1 cache. These tests check this
+  reuse distance, which makes a software k cache unnecessary on this backend.
+*/
+
+using namespace gridtools;
+
+namespace {
+    using point_t = std::tuple<int_t, int_t, int_t>;
+
+    struct recording_iterate_domain {
+        std::vector<point_t> m_visits;
+        int_t m_j = 0;
+        int_t m_k = 0;
+
+        void set_i_block_index(int_t i) { m_visits.emplace_back(i, m_j, m_k); }
+        void set_j_block_index(int_t j) { m_j = j; }
+        void set_k_block_index(int_t k) { m_k = k; }
+    };
+
+    template <class Extent>
+    struct recording_stage {
+        using extent_t = Extent;
+
+        static void exec(recording_iterate_domain &) {}
+    };
+
+    /**
+     * Returns the maximal number of points visited between a point and its previous neighbour in k.
+     */
+    template <class ExecutionType, class Stage>
+    int_t max_k_reuse_distance(int_t i_block_size, int_t j_block_size, int_t k_size) {
+        auto grid = make_grid(i_block_size, j_block_size, k_size);
+        using axis_t = decltype(grid)::axis_type;
+        using bottom_t = axis_t::FromLevel;
+        using top_t = level<1, -1, axis_t::offset_limit>;
+        constexpr bool backward = std::is_same<ExecutionType, execute::backward>::value;
+        using from_t = conditional_t<backward, top_t, bottom_t>;
+        using to_t = conditional_t<backward, bottom_t, top_t>;
+        execinfo_block_kserial_mc block{0, 0, i_block_size, j_block_size};
+        recording_iterate_domain it_domain;
+        using inner_functor_t = _impl_mss_loop_mc::
+            inner_functor_mc_kserial<ExecutionType, recording_iterate_domain, decltype(grid), from_t, to_t>;
+        inner_functor_t{it_domain, grid, block}(Stage{});
+
+        int_t k_step = backward ? -1 : 1;
+        std::map<point_t, int_t> last_visit;
+        int_t res = 0;
+        for (int_t n = 0; n < (int_t)it_domain.m_visits.size(); ++n) {
+            point_t const &point = it_domain.m_visits[n];
+            auto previous =
+                last_visit.find(point_t(std::get<0>(point), std::get<1>(point), std::get<2>(point) - k_step));
+            if (previous != last_visit.end())
+                res = std::max(res, n - previous->second);
+            last_visit[point] = n;
+        }
+        EXPECT_EQ(it_domain.m_visits.size(), last_visit.size());
+        return res;
+    }
+} // namespace
+
+TEST(mss_loop_mc, k_neighbours_are_one_row_apart) {
+    EXPECT_EQ(32, (max_k_reuse_distance<execute::forward, recording_stage<extent<>>>(32, 4, 10)));
+    EXPECT_EQ(32, (max_k_reuse_distance<execute::backward, recording_stage<extent<>>>(32, 4, 10)));
+}
+
+TEST(mss_loop_mc, k_neighbours_are_one_row_apart_with_extent) {
+    EXPECT_EQ(35, (max_k_reuse_distance<execute::forward, recording_stage<extent<-1, 2, -1, 1>>>(32, 4, 10)));
+}
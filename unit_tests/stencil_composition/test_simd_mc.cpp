@@ -0,0 +1,84 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/stencil_composition/structured_grids/backend_mc/simd_mc.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+using namespace gridtools;
+
+TEST(simd_pack, masked_load_store) {
+    std::vector<double> data = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    // only three lanes are active, inactive lanes replicate the last active one
+    simd_ref<double, 4, int_t> ref(data.data() + 1, 2, 3);
+    auto pack = ref.load();
+    EXPECT_EQ(pack[0], 1);
+    EXPECT_EQ(pack[1], 3);
+    EXPECT_EQ(pack[2], 5);
+    EXPECT_EQ(pack[3], 5);
+
+    ref = 2 * pack + 1;
+    EXPECT_EQ(data, (std::vector<double>{0, 3, 2, 7, 4, 11, 6, 7, 8, 9}));
+
+    simd_ref<double, 4, int_t> full(data.data(), 1, 4);
+    full -= full;
+    EXPECT_EQ(data, (std::vector<double>{0, 0, 0, 0, 4, 11, 6, 7, 8, 9}));
+}
+
+namespace {
+    struct lap {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+        using coeff = in_accessor<2>;
+        using param_list = make_param_list<out, in, coeff>;
+        using simd = std::true_type;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = eval(coeff()) * (4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) +
+                                                                eval(in(0, -1))));
+            eval(out()) += -eval(in()) / 2;
+        }
+    };
+
+    struct simd_mc : computation_fixture<1> {
+        // the i size is not a multiple of the vector width to test the masked tail
+        simd_mc() : computation_fixture<1>(GT_MC_SIMD_WIDTH * 3 + 5, 7, 4) {}
+    };
+} // namespace
+
+TEST_F(simd_mc, stencil) {
+    static_assert(is_simd_functor<lap>::value, "");
+
+    auto in = [](int_t i, int_t j, int_t k) { return i * i + 3. * j - k; };
+    auto coeff = [](int_t i, int_t j, int_t) { return 1 + .1 * j; };
+    auto ref = [&](int_t i, int_t j, int_t k) {
+        return coeff(i, j, k) * (4 * in(i, j, k) - (in(i + 1, j, k) + in(i, j + 1, k) + in(i - 1, j, k) +
+                                                       in(i, j - 1, k))) -
+               in(i, j, k) / 2;
+    };
+    auto out = make_storage(-1.);
+    using j_storage_info_t = storage_tr::special_storage_info_t<1, selector<0, 1, 0>, halo_t>;
+    using j_storage_type = storage_tr::data_store_t<float_type, j_storage_info_t>;
+    arg<2, j_storage_type> p_coeff;
+
+    make_computation(p_0 = out,
+        p_1 = make_storage(in),
+        p_coeff = make_storage<j_storage_type>(coeff),
+        make_multistage(execute::parallel(), make_stage<lap>(p_0, p_1, p_coeff)))
+        .run();
+
+    verify(make_storage(ref), out);
+}
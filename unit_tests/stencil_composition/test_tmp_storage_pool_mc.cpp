@@ -0,0 +1,155 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define GT_MC_TMP_POOL
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/stencil_composition/structured_grids/backend_mc/tmp_storage_pool_mc.hpp>
+#include <gridtools/tools/computation_fixture.hpp>
+
+using namespace gridtools;
+
+TEST(tmp_storage_pool_mc, usage) {
+    auto &pool = tmp_storage_pool_mc::get();
+    pool.shrink();
+
+    pool.acquire(1000);
+    EXPECT_EQ(pool.current_usage(), 1000);
+    EXPECT_GE(pool.peak_usage(), 1000);
+    EXPECT_EQ(pool.reserved(), 1000);
+    pool.release();
+    EXPECT_EQ(pool.current_usage(), 0);
+
+    // smaller blocks reuse the memory
+    void *ptr = pool.acquire(10);
+    EXPECT_EQ(pool.current_usage(), 10);
+    EXPECT_EQ(pool.reserved(), 1000);
+    pool.release();
+
+    // larger blocks grow the pool
+    EXPECT_NE(pool.acquire(2000), nullptr);
+    EXPECT_EQ(pool.reserved(), 2000);
+    EXPECT_GE(pool.peak_usage(), 2000);
+    pool.release();
+    (void)ptr;
+
+    pool.shrink();
+    EXPECT_EQ(pool.reserved(), 0);
+}
+
+TEST(tmp_storage_pool_mc, nested) {
+    auto &pool = tmp_storage_pool_mc::get();
+    pool.shrink();
+
+    char *outer = static_cast<char *>(pool.acquire(4096));
+    EXPECT_EQ(pool.reserved(), 4096);
+
+    // a nested block that does not fit is allocated separately, the outer block stays valid
+    char *inner = static_cast<char *>(pool.acquire(8192));
+    EXPECT_EQ(pool.current_usage(), 3 * 4096);
+    EXPECT_EQ(pool.reserved(), 3 * 4096);
+    outer[4095] = 1;
+    inner[8191] = 2;
+    EXPECT_EQ(outer[4095], 1);
+    pool.release();
+    EXPECT_EQ(pool.current_usage(), 4096);
+    EXPECT_EQ(pool.reserved(), 4096);
+    pool.release();
+    EXPECT_EQ(pool.current_usage(), 0);
+
+    // the next time, both blocks are carved from a single chunk
+    outer = static_cast<char *>(pool.acquire(4096));
+    EXPECT_EQ(pool.reserved(), 3 * 4096);
+    inner = static_cast<char *>(pool.acquire(8192));
+    EXPECT_EQ(inner, outer + 4096);
+    EXPECT_EQ(pool.reserved(), 3 * 4096);
+    EXPECT_EQ(pool.peak_usage(), 3 * 4096);
+
+    pool.release();
+
+    // blocks start at page boundaries
+    EXPECT_EQ(static_cast<char *>(pool.acquire(10)), outer + 4096);
+    EXPECT_EQ(static_cast<char *>(pool.acquire(10)), outer + 2 * 4096);
+    EXPECT_EQ(pool.reserved(), 3 * 4096);
+    pool.release();
+    pool.release();
+    pool.release();
+
+    pool.shrink();
+}
+
+namespace {
+    struct scale {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = 2 * eval(in());
+        }
+    };
+
+    struct lap {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+        }
+    };
+
+    struct tmp_storage_pool : computation_fixture<2> {
+        tmp_storage_pool() : computation_fixture<2>(13, 9, 7) {}
+    };
+} // namespace
+
+TEST_F(tmp_storage_pool, shared_by_computations) {
+    auto in = [](int_t i, int_t j, int_t k) { return i * i + 3. * j - k; };
+    auto twice_lap = [&](int_t i, int_t j, int_t k) {
+        return 2 * (4 * in(i, j, k) - (in(i + 1, j, k) + in(i, j + 1, k) + in(i - 1, j, k) + in(i, j - 1, k)));
+    };
+    auto lap_lap = [&](int_t i, int_t j, int_t k) {
+        auto lap = [&](int_t i, int_t j) {
+            return 4 * in(i, j, k) - (in(i + 1, j, k) + in(i, j + 1, k) + in(i - 1, j, k) + in(i, j - 1, k));
+        };
+        return 2 * (4 * lap(i, j) - (lap(i + 1, j) + lap(i, j + 1) + lap(i - 1, j) + lap(i, j - 1)));
+    };
+
+    auto out_a = make_storage(-1.);
+    auto out_b = make_storage(-1.);
+    auto comp_a = make_computation(p_0 = out_a,
+        p_1 = make_storage(in),
+        make_multistage(
+            execute::parallel(), make_stage<lap>(p_tmp_0, p_1), make_stage<scale>(p_0, p_tmp_0)));
+    auto comp_b = make_computation(p_0 = out_b,
+        p_1 = make_storage(in),
+        make_multistage(execute::parallel(),
+            make_stage<lap>(p_tmp_0, p_1),
+            make_stage<scale>(p_tmp_1, p_tmp_0),
+            make_stage<lap>(p_0, p_tmp_1)));
+
+    comp_a.run();
+    comp_b.run();
+    comp_a.run();
+    verify(make_storage(twice_lap), out_a);
+    verify(make_storage(lap_lap), out_b);
+
+#ifdef GT_BACKEND_MC
+    auto &pool = tmp_storage_pool_mc::get();
+    EXPECT_EQ(pool.current_usage(), 0);
+    EXPECT_GT(pool.peak_usage(), 0);
+    EXPECT_EQ(pool.reserved(), pool.peak_usage());
+#endif
+}
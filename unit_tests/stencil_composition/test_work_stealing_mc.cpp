@@ -0,0 +1,69 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include <omp.h>
+
+#include <gridtools/stencil_composition/backend_mc/work_stealing_mc.hpp>
+
+using namespace gridtools;
+
+TEST(work_stealing_mc, all_blocks_executed_once) {
+    for (int_t blocks : {0, 1, 7, 100, 1013}) {
+        std::vector<std::atomic<int>> counts(blocks);
+        for (auto &count : counts)
+            count = 0;
+
+        work_stealing_mc(blocks, [&](int_t b) { ++counts[b]; });
+
+        for (int_t b = 0; b < blocks; ++b)
+            EXPECT_EQ(counts[b], 1);
+    }
+}
+
+TEST(work_stealing_mc, uneven_work) {
+    const int_t blocks = 64 * omp_get_max_threads();
+    std::vector<std::atomic<int>> counts(blocks);
+    for (auto &count : counts)
+        count = 0;
+    std::vector<int> executing_thread(blocks, -1);
+    std::atomic<int> threads(1);
+
+    // blocks of the first thread are much more expensive than all others
+    work_stealing_mc(blocks, [&](int_t b) {
+        threads = omp_get_num_threads();
+        volatile double sink = 0;
+        const int_t work = b < blocks / omp_get_num_threads() ? 100000 : 10;
+        for (int_t i = 0; i < work; ++i)
+            sink = sink + i;
+        executing_thread[b] = omp_get_thread_num();
+        ++counts[b];
+    });
+
+    for (int_t b = 0; b < blocks; ++b) {
+        EXPECT_EQ(counts[b], 1);
+        EXPECT_GE(executing_thread[b], 0);
+        EXPECT_LT(executing_thread[b], omp_get_max_threads());
+    }
+
+    // the other threads finish their own blocks long before the first one, so they steal from its range
+    int_t stolen = 0;
+    for (int_t b = 0; b < blocks / threads; ++b)
+        if (executing_thread[b] != 0)
+            ++stolen;
+    if (threads > 1)
+        EXPECT_GT(stolen, 0);
+    else
+        EXPECT_EQ(stolen, 0);
+}
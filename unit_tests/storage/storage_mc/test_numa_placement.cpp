@@ -0,0 +1,77 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include <gridtools/storage/common/storage_info.hpp>
+#include <gridtools/storage/data_store.hpp>
+#include <gridtools/storage/storage_mc/data_view_helpers.hpp>
+#include <gridtools/storage/storage_mc/mc_storage.hpp>
+
+using namespace gridtools;
+
+namespace {
+    // all points of the storage, including halos, are touched exactly once
+    template <class StorageInfo, class Placement>
+    void check_touched(StorageInfo const &info, Placement placement) {
+        std::vector<int> data(info.padded_total_length(), -1);
+        numa_place_mc(placement, info, data.data());
+        std::vector<int> expected(data.size(), -1);
+        for (int i = 0; i < info.template total_length<0>(); ++i)
+            for (int j = 0; j < info.template total_length<1>(); ++j)
+                for (int k = 0; k < info.template total_length<2>(); ++k)
+                    expected[info.index(i, j, k)] = 0;
+        EXPECT_EQ(data, expected);
+    }
+} // namespace
+
+TEST(NumaPlacement, FirstTouch) {
+    check_touched(storage_info<0, layout_map<2, 0, 1>>(37, 11, 5), numa_placement_mc::first_touch{});
+    check_touched(storage_info<0, layout_map<2, 0, 1>, halo<2, 3, 0>>(37, 11, 5), numa_placement_mc::first_touch{});
+    check_touched(
+        storage_info<0, layout_map<2, 0, 1>, halo<1, 1, 0>, alignment<8>>(9, 13, 2), numa_placement_mc::first_touch{});
+    check_touched(storage_info<0, layout_map<0, 1, 2>>(9, 13, 2), numa_placement_mc::first_touch{});
+    check_touched(storage_info<0, layout_map<1, -1, 0>>(17, 1, 3), numa_placement_mc::first_touch{});
+}
+
+TEST(NumaPlacement, FirstTouch1D) {
+    storage_info<0, layout_map<0>> info(123);
+    std::vector<int> data(info.padded_total_length(), -1);
+    numa_place_mc(numa_placement_mc::first_touch{}, info, data.data());
+    EXPECT_EQ(data, std::vector<int>(data.size(), 0));
+}
+
+// only storages with a placement policy initialize the memory after placing it
+static_assert(storage_has_placement<mc_storage<double, numa_placement_mc::first_touch>>::value, "");
+static_assert(!storage_has_placement<mc_storage<double, numa_placement_mc::none>>::value, "");
+
+TEST(NumaPlacement, DataStore) {
+    using storage_info_t = storage_info<0, layout_map<2, 0, 1>, halo<1, 1, 0>>;
+    using data_store_t = data_store<mc_storage<double, numa_placement_mc::first_touch>, storage_info_t>;
+    storage_info_t info(13, 7, 4);
+
+    data_store_t by_value(info, 3.5);
+    data_store_t by_lambda(info, [](int i, int j, int k) { return i + 10 * j + 100 * k; });
+    auto value_view = make_host_view(by_value);
+    auto lambda_view = make_host_view(by_lambda);
+    for (int i = 0; i < 13; ++i)
+        for (int j = 0; j < 7; ++j)
+            for (int k = 0; k < 4; ++k) {
+                EXPECT_EQ(value_view(i, j, k), 3.5);
+                EXPECT_EQ(lambda_view(i, j, k), i + 10 * j + 100 * k);
+            }
+
+    // external memory is not touched
+    std::vector<double> external(info.padded_total_length(), -1);
+    data_store_t by_pointer(info, external.data());
+    EXPECT_EQ(external, std::vector<double>(external.size(), -1));
+}
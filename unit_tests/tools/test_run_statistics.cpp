@@ -0,0 +1,69 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/tools/run_statistics.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gridtools {
+    namespace {
+        TEST(run_statistics, single_run) {
+            auto res = compute_run_statistics({2.5});
+            EXPECT_EQ(res.count, 1);
+            EXPECT_EQ(res.min, 2.5);
+            EXPECT_EQ(res.max, 2.5);
+            EXPECT_EQ(res.mean, 2.5);
+            EXPECT_EQ(res.stddev, 0);
+            EXPECT_EQ(res.median, 2.5);
+            EXPECT_EQ(res.median_ci_low, 2.5);
+            EXPECT_EQ(res.median_ci_high, 2.5);
+            EXPECT_EQ(res.p05, 2.5);
+            EXPECT_EQ(res.p95, 2.5);
+        }
+
+        TEST(run_statistics, unsorted_runs) {
+            std::vector<double> times;
+            for (int i = 100; i > 0; --i)
+                times.push_back(i);
+            std::rotate(times.begin(), times.begin() + 37, times.end());
+
+            auto res = compute_run_statistics(times);
+            EXPECT_EQ(res.count, 100);
+            EXPECT_EQ(res.min, 1);
+            EXPECT_EQ(res.max, 100);
+            EXPECT_DOUBLE_EQ(res.mean, 50.5);
+            EXPECT_DOUBLE_EQ(res.stddev, std::sqrt(100. * 101 / 12));
+            EXPECT_DOUBLE_EQ(res.mean_ci_low, 50.5 - 1.96 * res.stddev / 10);
+            EXPECT_DOUBLE_EQ(res.mean_ci_high, 50.5 + 1.96 * res.stddev / 10);
+
+            // interpolated like numpy.percentile
+            EXPECT_DOUBLE_EQ(res.median, 50.5);
+            EXPECT_DOUBLE_EQ(res.p05, 5.95);
+            EXPECT_DOUBLE_EQ(res.p25, 25.75);
+            EXPECT_DOUBLE_EQ(res.p75, 75.25);
+            EXPECT_DOUBLE_EQ(res.p95, 95.05);
+
+            // order statistics of ranks 40 and 61
+            EXPECT_EQ(res.median_ci_low, 40);
+            EXPECT_EQ(res.median_ci_high, 61);
+        }
+
+        TEST(run_statistics, few_runs) {
+            auto res = compute_run_statistics({3, 1, 2});
+            EXPECT_EQ(res.median, 2);
+            EXPECT_EQ(res.median_ci_low, 1);
+            EXPECT_EQ(res.median_ci_high, 3);
+            EXPECT_DOUBLE_EQ(res.p25, 1.5);
+        }
+    } // namespace
+} // namespace gridtools
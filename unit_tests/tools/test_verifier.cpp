@@ -0,0 +1,109 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/tools/verifier.hpp>
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        using storage_traits_t = storage_traits<backend_t>;
+        using storage_info_t = storage_traits_t::storage_info_t<0, 3, halo<1, 1, 0>>;
+        using storage_t = storage_traits_t::data_store_t<double, storage_info_t>;
+        using ij_storage_info_t = storage_traits_t::special_storage_info_t<1, selector<1, 1, 0>>;
+        using ij_storage_t = storage_traits_t::data_store_t<double, ij_storage_info_t>;
+        using int_storage_t = storage_traits_t::data_store_t<int, storage_info_t>;
+
+        struct fake_grid {};
+
+        double value(int i, int j, int k) { return i + 10 * j + 100 * k; }
+
+        TEST(verifier, equal_fields) {
+            storage_info_t info(13, 9, 7);
+            storage_t expected(info, value);
+            storage_t actual(info, value);
+
+            auto res = verifier(1e-12).compare(fake_grid{}, expected, actual);
+            EXPECT_TRUE(res.passed());
+            EXPECT_EQ(res.points, 13 * 9 * 7);
+            EXPECT_EQ(res.error_count, 0);
+            EXPECT_EQ(res.max_error, 0);
+            EXPECT_EQ(res.rms_error, 0);
+            EXPECT_TRUE(verifier(1e-12).verify(fake_grid{}, expected, actual));
+        }
+
+        TEST(verifier, norms) {
+            storage_info_t info(13, 9, 7);
+            storage_t expected(info, value);
+            storage_t actual(info, value);
+            {
+                auto view = make_host_view(actual);
+                view(3, 4, 5) += 2;
+                view(12, 8, 6) -= 1;
+                // in the halo
+                view(0, 4, 2) += 8;
+            }
+
+            auto res = verifier(1e-12).compare(fake_grid{}, expected, actual);
+            EXPECT_FALSE(res.passed());
+            EXPECT_EQ(res.points, 13 * 9 * 7);
+            EXPECT_EQ(res.error_count, 3);
+            EXPECT_EQ(res.max_error, 8);
+            EXPECT_DOUBLE_EQ(res.rms_error, std::sqrt((4. + 1 + 64) / (13 * 9 * 7)));
+            EXPECT_FALSE(verifier(1e-12).verify(fake_grid{}, expected, actual));
+
+            // the halos are not compared
+            res = verifier(1e-12).compare(fake_grid{}, expected, actual, {{{1, 1}, {1, 1}, {0, 0}}});
+            EXPECT_EQ(res.points, 11 * 7 * 7);
+            EXPECT_EQ(res.error_count, 1);
+            EXPECT_EQ(res.max_error, 2);
+        }
+
+        TEST(verifier, precision) {
+            storage_info_t info(5, 6, 7);
+            storage_t expected(info, 1.);
+            storage_t actual(info, 1. + 1e-10);
+
+            EXPECT_TRUE(verifier(1e-8).verify(fake_grid{}, expected, actual));
+            auto res = verifier(1e-12).compare(fake_grid{}, expected, actual);
+            EXPECT_EQ(res.error_count, 5 * 6 * 7);
+            EXPECT_NEAR(res.max_error, 1e-10, 1e-15);
+            EXPECT_NEAR(res.rms_error, 1e-10, 1e-15);
+        }
+
+        TEST(verifier, masked_dimension) {
+            ij_storage_info_t info(6, 5, 4);
+            ij_storage_t expected(info, [](int i, int j, int) { return i + 10 * j; });
+            ij_storage_t actual(info, [](int i, int j, int) { return i + 10 * j; });
+            make_host_view(actual)(2, 3, 0) = 0;
+
+            auto res = verifier(1e-12).compare(fake_grid{}, expected, actual);
+            // the masked dimension is walked like the others
+            EXPECT_EQ(res.points, 6 * 5 * 4);
+            EXPECT_EQ(res.error_count, 4);
+            EXPECT_EQ(res.max_error, 32);
+        }
+
+        TEST(verifier, integers) {
+            storage_info_t info(4, 5, 6);
+            int_storage_t expected(info, 3);
+            int_storage_t actual(info, 3);
+            make_host_view(actual)(1, 2, 3) = 5;
+
+            auto res = verifier(0).compare(fake_grid{}, expected, actual);
+            EXPECT_EQ(res.error_count, 1);
+            EXPECT_EQ(res.max_error, 2);
+        }
+    } // namespace
+} // namespace gridtools